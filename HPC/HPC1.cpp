@@ -1,12 +1,17 @@
 #include <iostream>
 #include <vector>
-#include <omp.h>
+#include <atomic>
+#include <mutex>
+#include "ThreadPool.h"
+#include "PerfCounters.h"
 
 using namespace std;
 
+mutex outputLock;
+
 void parallelBFS(const vector<vector<int>>& graph, int start) {
     int n = graph.size();
-    vector<int> visited(n, 0);
+    vector<atomic<int>> visited(n);
     vector<int> frontier;
 
     visited[start] = 1;
@@ -16,32 +21,27 @@ void parallelBFS(const vector<vector<int>>& graph, int start) {
 
     while (!frontier.empty()) {
         vector<int> next_frontier;
+        mutex nextLock;
 
-        #pragma omp parallel
-        {
+        parallelFor(0, frontier.size(), [&](long long lo, long long hi) {
             vector<int> local_next;
 
-            #pragma omp for nowait
-            for (int i = 0; i < frontier.size(); ++i) {
+            for (long long i = lo; i < hi; ++i) {
                 int u = frontier[i];
 
-                #pragma omp critical
-                cout << u << " ";
-
-                for (int v : graph[u]) {
-                    #pragma omp critical
-                    {
-                        if (visited[v] == 0) {
-                            visited[v] = 1;
-                            local_next.push_back(v);
-                        }
-                    }
+                {
+                    lock_guard<mutex> guard(outputLock);
+                    cout << u << " ";
                 }
+
+                for (int v : graph[u])
+                    if (visited[v].exchange(1) == 0)
+                        local_next.push_back(v);
             }
 
-            #pragma omp critical
+            lock_guard<mutex> guard(nextLock);
             next_frontier.insert(next_frontier.end(), local_next.begin(), local_next.end());
-        }
+        });
 
         frontier = next_frontier;
     }
@@ -49,44 +49,28 @@ void parallelBFS(const vector<vector<int>>& graph, int start) {
     cout << endl;
 }
 
-void parallelDFSUtil(const vector<vector<int>>& graph, int node, vector<int>& visited) {
-    bool alreadyVisited;
+void parallelDFSUtil(const vector<vector<int>>& graph, int node, vector<atomic<int>>& visited) {
+    if (visited[node].exchange(1)) return;
 
-    #pragma omp critical
     {
-        alreadyVisited = visited[node];
-        if (!alreadyVisited) {
-            visited[node] = 1;
-            cout << node << " ";
-        }
-    }
-
-    if (alreadyVisited) return;
-
-    #pragma omp parallel for
-    for (int i = 0; i < graph[node].size(); ++i) {
-        int v = graph[node][i];
-
-        if (!visited[v]) {
-            #pragma omp task
-            parallelDFSUtil(graph, v, visited);
-        }
+        lock_guard<mutex> guard(outputLock);
+        cout << node << " ";
     }
 
-    #pragma omp taskwait
+    TaskGroup group;
+    for (int v : graph[node])
+        if (!visited[v])
+            group.run([&graph, v, &visited] { parallelDFSUtil(graph, v, visited); });
+    group.wait();
 }
 
 void parallelDFS(const vector<vector<int>>& graph, int start) {
     int n = graph.size();
-    vector<int> visited(n, 0);
+    vector<atomic<int>> visited(n);
 
     cout << "Parallel DFS: ";
 
-    #pragma omp parallel
-    {
-        #pragma omp single
-        parallelDFSUtil(graph, start, visited);
-    }
+    parallelDFSUtil(graph, start, visited);
 
     cout << endl;
 }
@@ -103,8 +87,17 @@ int main() {
 
     int startNode = 0;
 
-    parallelBFS(graph, startNode);
-    parallelDFS(graph, startNode);
+    ThreadPool::global().park();
+    KernelCounters counters = countKernel("Parallel BFS", graph.size(), [&] {
+        parallelBFS(graph, startNode);
+    });
+    printCounters(counters);
+
+    ThreadPool::global().park();
+    counters = countKernel("Parallel DFS", graph.size(), [&] {
+        parallelDFS(graph, startNode);
+    });
+    printCounters(counters);
 
     return 0;
 }
@@ -1,15 +1,20 @@
 #include <iostream>
 #include <vector>
-#include <omp.h>
+#include <atomic>
+#include <mutex>
+#include "ThreadPool.h"  // Persistent work-stealing thread pool
+#include "PerfCounters.h" // Per-thread hardware counters via perf_event_open
 
 using namespace std;
 
+mutex outputLock;  // Serializes printing so output is not garbled
+
 // ----------------------------
-// Parallel Breadth-First Search (BFS) using OpenMP
+// Parallel Breadth-First Search (BFS) on the thread pool
 // ----------------------------
 void parallelBFS(const vector<vector<int>>& graph, int start) {
     int n = graph.size();
-    vector<int> visited(n, 0);       // Keeps track of visited nodes
+    vector<atomic<int>> visited(n);  // Keeps track of visited nodes (atomic claim)
     vector<int> frontier;            // Current BFS frontier (nodes to explore)
 
     visited[start] = 1;
@@ -19,38 +24,32 @@ void parallelBFS(const vector<vector<int>>& graph, int start) {
 
     while (!frontier.empty()) {
         vector<int> next_frontier;   // Stores nodes for the next level of BFS
+        mutex nextLock;              // Guards next_frontier
 
-        // Parallel region for processing the current frontier
-        #pragma omp parallel
-        {
-            vector<int> local_next;  // Thread-local storage for discovered nodes
+        // Split the frontier into pieces run by the pool's persistent threads
+        parallelFor(0, frontier.size(), [&](long long lo, long long hi) {
+            vector<int> local_next;  // Piece-local storage for discovered nodes
 
-            // Distribute frontier processing among threads
-            #pragma omp for nowait
-            for (int i = 0; i < frontier.size(); ++i) {
+            for (long long i = lo; i < hi; ++i) {
                 int u = frontier[i];
 
-                // Print node (use critical section to avoid garbled output)
-                #pragma omp critical
-                cout << u << " ";
-
-                // Explore neighbors
-                for (int v : graph[u]) {
-                    // Check and mark visited inside a critical section
-                    #pragma omp critical
-                    {
-                        if (visited[v] == 0) {
-                            visited[v] = 1;
-                            local_next.push_back(v);
-                        }
-                    }
+                // Print node (locked to avoid garbled output)
+                {
+                    lock_guard<mutex> guard(outputLock);
+                    cout << u << " ";
                 }
+
+                // Explore neighbors; exchange() marks visited and tells
+                // whether this thread was the first to get there
+                for (int v : graph[u])
+                    if (visited[v].exchange(1) == 0)
+                        local_next.push_back(v);
             }
 
-            // Merge thread-local results into global next_frontier
-            #pragma omp critical
+            // Merge piece-local results into global next_frontier
+            lock_guard<mutex> guard(nextLock);
             next_frontier.insert(next_frontier.end(), local_next.begin(), local_next.end());
-        }
+        });
 
         frontier = next_frontier;  // Move to next level
     }
@@ -59,49 +58,34 @@ void parallelBFS(const vector<vector<int>>& graph, int start) {
 }
 
 // ----------------------------
-// Parallel Depth-First Search (DFS) using OpenMP tasks
+// Parallel Depth-First Search (DFS) using pool tasks
 // ----------------------------
-void parallelDFSUtil(const vector<vector<int>>& graph, int node, vector<int>& visited) {
-    bool alreadyVisited;
-
+void parallelDFSUtil(const vector<vector<int>>& graph, int node, vector<atomic<int>>& visited) {
     // Atomically check and mark node as visited
-    #pragma omp critical
-    {
-        alreadyVisited = visited[node];
-        if (!alreadyVisited) {
-            visited[node] = 1;
-            cout << node << " ";
-        }
-    }
+    if (visited[node].exchange(1)) return;
 
-    if (alreadyVisited) return;
-
-    // Parallelize over neighbors using tasks
-    #pragma omp parallel for
-    for (int i = 0; i < graph[node].size(); ++i) {
-        int v = graph[node][i];
-
-        if (!visited[v]) {
-            #pragma omp task
-            parallelDFSUtil(graph, v, visited);
-        }
+    {
+        lock_guard<mutex> guard(outputLock);
+        cout << node << " ";
     }
 
-    #pragma omp taskwait  // Wait for all tasks to complete
+    // One task per unvisited neighbor; wait() helps run queued tasks,
+    // so the recursion never starts extra threads
+    TaskGroup group;
+    for (int v : graph[node])
+        if (!visited[v])
+            group.run([&graph, v, &visited] { parallelDFSUtil(graph, v, visited); });
+    group.wait();  // Wait for all tasks to complete
 }
 
-// Wrapper to launch DFS in parallel region
+// Wrapper to launch DFS; the pool's threads are already running
 void parallelDFS(const vector<vector<int>>& graph, int start) {
     int n = graph.size();
-    vector<int> visited(n, 0);
+    vector<atomic<int>> visited(n);
 
     cout << "Parallel DFS: ";
 
-    #pragma omp parallel
-    {
-        #pragma omp single
-        parallelDFSUtil(graph, start, visited);
-    }
+    parallelDFSUtil(graph, start, visited);
 
     cout << endl;
 }
@@ -122,8 +106,22 @@ int main() {
 
     int startNode = 0;
 
-    parallelBFS(graph, startNode);
-    parallelDFS(graph, startNode);
+    // Start the pool's threads and park them, so a worker is only counted
+    // if it wakes for one of the kernel's tasks
+    ThreadPool::global().park();
+
+    // Run each search under per-thread counters and print them
+    KernelCounters counters = countKernel("Parallel BFS", graph.size(), [&] {
+        parallelBFS(graph, startNode);
+    });
+    printCounters(counters);
+
+    // Park the workers again before the next kernel
+    ThreadPool::global().park();
+    counters = countKernel("Parallel DFS", graph.size(), [&] {
+        parallelDFS(graph, startNode);
+    });
+    printCounters(counters);
 
     return 0;
 }
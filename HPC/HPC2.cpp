@@ -1,8 +1,10 @@
 #include <iostream>
 #include <vector>
 #include <chrono>
-#include <omp.h>
 #include <algorithm>
+#include "ParallelRandom.h"
+#include "ThreadPool.h"
+#include "PerfCounters.h"
 
 using namespace std;
 using namespace chrono;
@@ -18,12 +20,16 @@ void sequentialBubbleSort(vector<int>& arr) {
 void parallelBubbleSort(vector<int>& arr) {
     int n = arr.size();
     for (int i = 0; i < n; ++i) {
-        #pragma omp parallel for
-        for (int j = i % 2; j < n - 1; j += 2) {
-            if (arr[j] > arr[j + 1]) {
-                swap(arr[j], arr[j + 1]);
+        int first = i % 2;
+        long long pairs = (n - first) / 2;
+        parallelFor(0, pairs, [&](long long lo, long long hi) {
+            for (long long p = lo; p < hi; ++p) {
+                int j = first + 2 * p;
+                if (arr[j] > arr[j + 1]) {
+                    swap(arr[j], arr[j + 1]);
+                }
             }
-        }
+        });
     }
 }
 
@@ -60,13 +66,8 @@ void parallelMergeSort(vector<int>& arr, int l, int r, int depth = 0) {
         int m = l + (r - l) / 2;
 
         if (depth < 4) {
-            #pragma omp parallel sections
-            {
-                #pragma omp section
-                parallelMergeSort(arr, l, m, depth + 1);
-                #pragma omp section
-                parallelMergeSort(arr, m + 1, r, depth + 1);
-            }
+            parallelInvoke([&] { parallelMergeSort(arr, l, m, depth + 1); },
+                           [&] { parallelMergeSort(arr, m + 1, r, depth + 1); });
         } else {
             sequentialMergeSort(arr, l, m);
             sequentialMergeSort(arr, m + 1, r);
@@ -78,39 +79,54 @@ void parallelMergeSort(vector<int>& arr, int l, int r, int depth = 0) {
 
 void measureSortPerformance() {
     const int SIZE = 5000;
+    const uint64_t SEED = 2024;
     vector<int> original(SIZE);
 
-    srand(time(0));
-    for (int i = 0; i < SIZE; ++i)
-        original[i] = rand() % 10000;
+    fillUniformInt(original, 0, 9999, SEED);
 
     vector<int> bubbleSeq = original;
+    ThreadPool::global().park();
     auto start = high_resolution_clock::now();
-    sequentialBubbleSort(bubbleSeq);
+    KernelCounters counters = countKernel("Sequential Bubble Sort", SIZE, [&] {
+        sequentialBubbleSort(bubbleSeq);
+    });
     auto end = high_resolution_clock::now();
     cout << "Sequential Bubble Sort Time: " 
          << duration_cast<milliseconds>(end - start).count() << " ms\n";
+    printCounters(counters);
 
     vector<int> bubblePar = original;
+    ThreadPool::global().park();
     start = high_resolution_clock::now();
-    parallelBubbleSort(bubblePar);
+    counters = countKernel("Parallel Bubble Sort", SIZE, [&] {
+        parallelBubbleSort(bubblePar);
+    });
     end = high_resolution_clock::now();
     cout << "Parallel Bubble Sort Time: " 
          << duration_cast<milliseconds>(end - start).count() << " ms\n";
+    printCounters(counters);
 
     vector<int> mergeSeq = original;
+    ThreadPool::global().park();
     start = high_resolution_clock::now();
-    sequentialMergeSort(mergeSeq, 0, mergeSeq.size() - 1);
+    counters = countKernel("Sequential Merge Sort", SIZE, [&] {
+        sequentialMergeSort(mergeSeq, 0, mergeSeq.size() - 1);
+    });
     end = high_resolution_clock::now();
     cout << "Sequential Merge Sort Time: " 
          << duration_cast<milliseconds>(end - start).count() << " ms\n";
+    printCounters(counters);
 
     vector<int> mergePar = original;
+    ThreadPool::global().park();
     start = high_resolution_clock::now();
-    parallelMergeSort(mergePar, 0, mergePar.size() - 1);
+    counters = countKernel("Parallel Merge Sort", SIZE, [&] {
+        parallelMergeSort(mergePar, 0, mergePar.size() - 1);
+    });
     end = high_resolution_clock::now();
     cout << "Parallel Merge Sort Time: " 
          << duration_cast<milliseconds>(end - start).count() << " ms\n";
+    printCounters(counters);
 }
 
 int main() {
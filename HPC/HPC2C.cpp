@@ -1,8 +1,10 @@
 #include <iostream>
 #include <vector>
 #include <chrono>
-#include <omp.h>
 #include <algorithm>
+#include "ParallelRandom.h" // Counter-based parallel random generation
+#include "ThreadPool.h"     // Persistent work-stealing thread pool
+#include "PerfCounters.h"   // Per-thread hardware counters via perf_event_open
 
 using namespace std;
 using namespace chrono;
@@ -22,19 +24,23 @@ void sequentialBubbleSort(vector<int>& arr) {
 }
 
 // ------------------------------
-// Parallel Bubble Sort using OpenMP
+// Parallel Bubble Sort (odd-even transposition) on the thread pool
 // ------------------------------
 void parallelBubbleSort(vector<int>& arr) {
     int n = arr.size(); // Get the size of the array
     for (int i = 0; i < n; ++i) {
-        // Parallelize the inner loop for each iteration of the outer loop
-        #pragma omp parallel for
-        for (int j = i % 2; j < n - 1; j += 2) {
-            // Swap if elements are in wrong order
-            if (arr[j] > arr[j + 1]) {
-                swap(arr[j], arr[j + 1]);
+        int first = i % 2;                // Even phase compares (0,1),(2,3)...; odd phase (1,2),(3,4)...
+        long long pairs = (n - first) / 2; // Number of disjoint pairs in this phase
+        // Split the pairs over the pool; its threads stay alive between phases
+        parallelFor(0, pairs, [&](long long lo, long long hi) {
+            for (long long p = lo; p < hi; ++p) {
+                int j = first + 2 * p;
+                // Swap if elements are in wrong order
+                if (arr[j] > arr[j + 1]) {
+                    swap(arr[j], arr[j + 1]);
+                }
             }
-        }
+        });
     }
 }
 
@@ -77,7 +83,7 @@ void sequentialMergeSort(vector<int>& arr, int l, int r) {
 }
 
 // ------------------------------
-// Parallel Merge Sort using OpenMP
+// Parallel Merge Sort using pool tasks
 // ------------------------------
 void parallelMergeSort(vector<int>& arr, int l, int r, int depth = 0) {
     if (l < r) {
@@ -85,13 +91,9 @@ void parallelMergeSort(vector<int>& arr, int l, int r, int depth = 0) {
 
         // Parallelize the sorting if depth is less than 4
         if (depth < 4) {
-            #pragma omp parallel sections
-            {
-                #pragma omp section
-                parallelMergeSort(arr, l, m, depth + 1);
-                #pragma omp section
-                parallelMergeSort(arr, m + 1, r, depth + 1);
-            }
+            // Sort both halves at once; nested calls reuse the same threads
+            parallelInvoke([&] { parallelMergeSort(arr, l, m, depth + 1); },
+                           [&] { parallelMergeSort(arr, m + 1, r, depth + 1); });
         } else {
             sequentialMergeSort(arr, l, m); // Fall back to sequential if depth >= 4
             sequentialMergeSort(arr, m + 1, r); // Fall back to sequential if depth >= 4
@@ -106,44 +108,64 @@ void parallelMergeSort(vector<int>& arr, int l, int r, int depth = 0) {
 // ------------------------------
 void measureSortPerformance() {
     const int SIZE = 5000;
+    const uint64_t SEED = 2024; // Same seed gives the same data at any thread count
     vector<int> original(SIZE);
 
     // Generate random data
-    srand(time(0));
-    for (int i = 0; i < SIZE; ++i)
-        original[i] = rand() % 10000;
+    fillUniformInt(original, 0, 9999, SEED);
 
     // Sequential Bubble Sort
     vector<int> bubbleSeq = original;
+    // Start the pool's threads and park them, so a worker is only counted
+    // if it wakes for one of the kernel's tasks
+    ThreadPool::global().park();
     auto start = high_resolution_clock::now(); // Record start time
-    sequentialBubbleSort(bubbleSeq); // Call sequential bubble sort
+    KernelCounters counters = countKernel("Sequential Bubble Sort", SIZE, [&] {
+        sequentialBubbleSort(bubbleSeq); // Call sequential bubble sort
+    });
     auto end = high_resolution_clock::now(); // Record end time
     cout << "Sequential Bubble Sort Time: " 
          << duration_cast<milliseconds>(end - start).count() << " ms\n";
+    printCounters(counters);
 
     // Parallel Bubble Sort
     vector<int> bubblePar = original;
+    // Park the workers again before the next kernel
+    ThreadPool::global().park();
     start = high_resolution_clock::now();
-    parallelBubbleSort(bubblePar); // Call parallel bubble sort
+    counters = countKernel("Parallel Bubble Sort", SIZE, [&] {
+        parallelBubbleSort(bubblePar); // Call parallel bubble sort
+    });
     end = high_resolution_clock::now();
     cout << "Parallel Bubble Sort Time: " 
          << duration_cast<milliseconds>(end - start).count() << " ms\n";
+    printCounters(counters);
 
     // Sequential Merge Sort
     vector<int> mergeSeq = original;
+    // Park the workers again before the next kernel
+    ThreadPool::global().park();
     start = high_resolution_clock::now();
-    sequentialMergeSort(mergeSeq, 0, mergeSeq.size() - 1); // Call sequential merge sort
+    counters = countKernel("Sequential Merge Sort", SIZE, [&] {
+        sequentialMergeSort(mergeSeq, 0, mergeSeq.size() - 1); // Call sequential merge sort
+    });
     end = high_resolution_clock::now();
     cout << "Sequential Merge Sort Time: " 
          << duration_cast<milliseconds>(end - start).count() << " ms\n";
+    printCounters(counters);
 
     // Parallel Merge Sort
     vector<int> mergePar = original;
+    // Park the workers again before the next kernel
+    ThreadPool::global().park();
     start = high_resolution_clock::now();
-    parallelMergeSort(mergePar, 0, mergePar.size() - 1); // Call parallel merge sort
+    counters = countKernel("Parallel Merge Sort", SIZE, [&] {
+        parallelMergeSort(mergePar, 0, mergePar.size() - 1); // Call parallel merge sort
+    });
     end = high_resolution_clock::now();
     cout << "Parallel Merge Sort Time: " 
          << duration_cast<milliseconds>(end - start).count() << " ms\n";
+    printCounters(counters);
 }
 
 // ------------------------------
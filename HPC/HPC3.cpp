@@ -1,30 +1,48 @@
 #include <iostream>
 #include <vector>
-#include <cstdlib>
-#include <ctime>
-#include <omp.h>
+#include <algorithm>
+#include "ParallelRandom.h"
+#include "ThreadPool.h"
+#include "PerfCounters.h"
 
 using namespace std;
 
+struct MinMaxSum {
+    int minVal;
+    int maxVal;
+    long long sum;
+};
+
 int main() {
     const int SIZE = 1000000;
+    const int GRAIN = 1 << 14;
+    const uint64_t SEED = 2024;
     vector<int> data(SIZE);
 
-    srand(time(0));
-    for (int i = 0; i < SIZE; ++i) {
-        data[i] = rand() % 10000;
-    }
-
-    int minVal = data[0];
-    int maxVal = data[0];
-    long long sum = 0;
-
-    #pragma omp parallel for reduction(min:minVal) reduction(max:maxVal) reduction(+:sum)
-    for (int i = 0; i < SIZE; ++i) {
-        if (data[i] < minVal) minVal = data[i];
-        if (data[i] > maxVal) maxVal = data[i];
-        sum += data[i];
-    }
+    fillUniformInt(data, 0, 9999, SEED);
+
+    MinMaxSum identity = {data[0], data[0], 0};
+    MinMaxSum total;
+    ThreadPool::global().park();
+    KernelCounters counters = countKernel("Parallel Reduction", SIZE, [&] {
+        total = parallelReduce(0, SIZE, GRAIN, identity,
+            [&](long long lo, long long hi) {
+                MinMaxSum r = identity;
+                for (long long i = lo; i < hi; ++i) {
+                    if (data[i] < r.minVal) r.minVal = data[i];
+                    if (data[i] > r.maxVal) r.maxVal = data[i];
+                    r.sum += data[i];
+                }
+                return r;
+            },
+            [](const MinMaxSum& a, const MinMaxSum& b) {
+                return MinMaxSum{min(a.minVal, b.minVal), max(a.maxVal, b.maxVal), a.sum + b.sum};
+            });
+    });
+
+    int minVal = total.minVal;
+    int maxVal = total.maxVal;
+    long long sum = total.sum;
 
     double average = static_cast<double>(sum) / SIZE;
 
@@ -33,6 +51,7 @@ int main() {
     cout << "Max: " << maxVal << "\n";
     cout << "Sum: " << sum << "\n";
     cout << "Average: " << average << "\n";
+    printCounters(counters);
 
     return 0;
 }
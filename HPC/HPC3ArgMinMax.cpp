@@ -0,0 +1,203 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <omp.h>
+#include "ParallelRandom.h"
+
+using namespace std;
+
+struct ValueIndex {
+    int value;
+    long long index;
+};
+
+// Ties always go to the lower index, so the result does not depend on scheduling.
+inline ValueIndex minOf(ValueIndex a, ValueIndex b) {
+    if (b.value < a.value || (b.value == a.value && b.index < a.index)) return b;
+    return a;
+}
+
+inline ValueIndex maxOf(ValueIndex a, ValueIndex b) {
+    if (b.value > a.value || (b.value == a.value && b.index < a.index)) return b;
+    return a;
+}
+
+#pragma omp declare reduction(argmin : ValueIndex : omp_out = minOf(omp_out, omp_in)) initializer(omp_priv = omp_orig)
+#pragma omp declare reduction(argmax : ValueIndex : omp_out = maxOf(omp_out, omp_in)) initializer(omp_priv = omp_orig)
+
+const int LANES = 16;
+
+// Tracks LANES independent (value, index) pairs so the inner loop vectorizes
+// into compare + blend, then folds the lanes with the tie-breaking rule.
+void argMinMaxBlock(const int* data, long long begin, long long end, ValueIndex& lo, ValueIndex& hi) {
+    int minV[LANES], maxV[LANES];
+    long long minI[LANES], maxI[LANES];
+    for (int l = 0; l < LANES; ++l) {
+        minV[l] = maxV[l] = data[begin];
+        minI[l] = maxI[l] = begin;
+    }
+
+    long long i = begin;
+    for (; i + LANES <= end; i += LANES) {
+        #pragma omp simd
+        for (int l = 0; l < LANES; ++l) {
+            int v = data[i + l];
+            bool lt = v < minV[l];
+            bool gt = v > maxV[l];
+            minV[l] = lt ? v : minV[l];
+            minI[l] = lt ? i + l : minI[l];
+            maxV[l] = gt ? v : maxV[l];
+            maxI[l] = gt ? i + l : maxI[l];
+        }
+    }
+
+    lo = {minV[0], minI[0]};
+    hi = {maxV[0], maxI[0]};
+    for (int l = 1; l < LANES; ++l) {
+        lo = minOf(lo, {minV[l], minI[l]});
+        hi = maxOf(hi, {maxV[l], maxI[l]});
+    }
+    for (; i < end; ++i) {
+        lo = minOf(lo, {data[i], i});
+        hi = maxOf(hi, {data[i], i});
+    }
+}
+
+// An empty input has no extremes; both results get index -1.
+void parallelArgMinMax(const vector<int>& data, ValueIndex& lo, ValueIndex& hi) {
+    long long n = data.size();
+    if (n == 0) {
+        lo = hi = {0, -1};
+        return;
+    }
+    lo = {data[0], 0};
+    hi = {data[0], 0};
+
+    #pragma omp parallel reduction(argmin:lo) reduction(argmax:hi)
+    {
+        int t = omp_get_thread_num();
+        int nt = omp_get_num_threads();
+        long long begin = n * t / nt;
+        long long end = n * (t + 1) / nt;
+        if (begin < end) {
+            ValueIndex blockLo, blockHi;
+            argMinMaxBlock(data.data(), begin, end, blockLo, blockHi);
+            lo = minOf(lo, blockLo);
+            hi = maxOf(hi, blockHi);
+        }
+    }
+}
+
+// Orders "better" candidates first: larger value, then lower index.
+struct TopKOrder {
+    bool largest;
+    bool operator()(const ValueIndex& a, const ValueIndex& b) const {
+        if (a.value != b.value) return largest ? a.value > b.value : a.value < b.value;
+        return a.index < b.index;
+    }
+};
+
+// Each thread keeps a bounded heap whose top is its worst kept candidate; the
+// per-thread heaps are merged and the best k are returned in rank order.
+vector<ValueIndex> parallelTopK(const vector<int>& data, int k, bool largest = true) {
+    long long n = data.size();
+    TopKOrder better{largest};
+    vector<ValueIndex> merged;
+    if (k <= 0) return merged;
+
+    #pragma omp parallel
+    {
+        priority_queue<ValueIndex, vector<ValueIndex>, TopKOrder> heap(better);
+
+        #pragma omp for nowait
+        for (long long i = 0; i < n; ++i) {
+            ValueIndex c = {data[i], i};
+            if ((int)heap.size() < k) {
+                heap.push(c);
+            } else if (better(c, heap.top())) {
+                heap.pop();
+                heap.push(c);
+            }
+        }
+
+        vector<ValueIndex> local;
+        while (!heap.empty()) {
+            local.push_back(heap.top());
+            heap.pop();
+        }
+
+        #pragma omp critical
+        merged.insert(merged.end(), local.begin(), local.end());
+    }
+
+    int keep = min<long long>(k, merged.size());
+    partial_sort(merged.begin(), merged.begin() + keep, merged.end(), better);
+    merged.resize(keep);
+    return merged;
+}
+
+void sequentialArgMinMax(const vector<int>& data, ValueIndex& lo, ValueIndex& hi) {
+    lo = hi = {0, -1};
+    for (long long i = 0; i < (long long)data.size(); ++i) {
+        if (hi.index < 0 || data[i] > hi.value) hi = {data[i], i};
+        if (lo.index < 0 || data[i] < lo.value) lo = {data[i], i};
+    }
+}
+
+vector<ValueIndex> sequentialTopK(const vector<int>& data, int k, bool largest) {
+    vector<ValueIndex> all;
+    for (long long i = 0; i < (long long)data.size(); ++i)
+        all.push_back({data[i], i});
+    sort(all.begin(), all.end(), TopKOrder{largest});
+    all.resize(min<long long>(max(k, 0), all.size()));
+    return all;
+}
+
+bool sameEntries(const vector<ValueIndex>& a, const vector<ValueIndex>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (a[i].value != b[i].value || a[i].index != b[i].index) return false;
+    return true;
+}
+
+int main() {
+    const int SIZE = 1000000;
+    const int K = 5;
+    const uint64_t SEED = 2024;
+    vector<int> data(SIZE);
+
+    fillUniformInt(data, 0, 9999, SEED);
+
+    ValueIndex lo, hi;
+    parallelArgMinMax(data, lo, hi);
+
+    cout << "Parallel ArgMin/ArgMax Results:\n";
+    cout << "Min: " << lo.value << " at index " << lo.index << "\n";
+    cout << "Max: " << hi.value << " at index " << hi.index << "\n";
+
+    cout << "Top " << K << " largest:";
+    for (const ValueIndex& e : parallelTopK(data, K, true))
+        cout << " " << e.value << "@" << e.index;
+    cout << "\n";
+
+    cout << "Top " << K << " smallest:";
+    for (const ValueIndex& e : parallelTopK(data, K, false))
+        cout << " " << e.value << "@" << e.index;
+    cout << "\n";
+
+    ValueIndex seqLo, seqHi;
+    sequentialArgMinMax(data, seqLo, seqHi);
+    bool ok = lo.index == seqLo.index && hi.index == seqHi.index;
+    for (bool largest : {true, false})
+        ok = ok && sameEntries(parallelTopK(data, K, largest), sequentialTopK(data, K, largest));
+
+    // Empty input and k <= 0 return the empty answer instead of reading data[0].
+    vector<int> empty;
+    parallelArgMinMax(empty, lo, hi);
+    ok = ok && lo.index == -1 && hi.index == -1;
+    ok = ok && parallelTopK(empty, K).empty() && parallelTopK(data, 0).empty();
+    cout << "Correct: " << (ok ? "yes" : "no") << "\n";
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+#include <omp.h>
+#include "ParallelRandom.h"
+
+using namespace std;
+using namespace chrono;
+
+struct ArrayRef {
+    const int* data;
+    long long size;
+};
+
+struct BatchResult {
+    int minVal = INT_MAX;
+    int maxVal = INT_MIN;
+    long long sum = 0;
+    long long count = 0;
+    double average = 0.0;
+};
+
+// A contiguous range of one array; a work item is a run of pieces.
+struct Piece {
+    int array;
+    long long begin;
+    long long end;
+};
+
+// Left to the auto-vectorizer: an "omp simd" reduction here runs at half the speed.
+inline BatchResult reducePiece(const int* data, long long begin, long long end) {
+    int minVal = INT_MAX, maxVal = INT_MIN;
+    long long sum = 0;
+    for (long long i = begin; i < end; ++i) {
+        minVal = min(minVal, data[i]);
+        maxVal = max(maxVal, data[i]);
+        sum += data[i];
+    }
+    BatchResult r;
+    r.minVal = minVal;
+    r.maxVal = maxVal;
+    r.sum = sum;
+    r.count = end - begin;
+    return r;
+}
+
+// Reduces every array of the batch inside one parallel region, so the team of
+// threads is woken once per batch instead of once per array. Work is cut into
+// items of about `grain` elements: arrays larger than that are split into
+// several items, and smaller ones are packed together into one item. Items are
+// handed out dynamically. Pieces of a split array are combined afterwards in
+// array order.
+vector<BatchResult> batchedReduce(const vector<ArrayRef>& arrays, long long grain = 1 << 16) {
+    vector<Piece> pieces;
+    vector<size_t> itemStart;
+    vector<size_t> firstPiece(arrays.size() + 1);
+    long long packed = grain;
+
+    for (size_t a = 0; a < arrays.size(); ++a) {
+        firstPiece[a] = pieces.size();
+        long long n = arrays[a].size;
+        if (n >= grain) {
+            for (long long begin = 0; begin < n; begin += grain) {
+                itemStart.push_back(pieces.size());
+                pieces.push_back({(int)a, begin, min(n, begin + grain)});
+            }
+            packed = grain;
+        } else {
+            if (packed + n > grain) {
+                itemStart.push_back(pieces.size());
+                packed = 0;
+            }
+            pieces.push_back({(int)a, 0, n});
+            packed += n;
+        }
+    }
+    firstPiece[arrays.size()] = pieces.size();
+    itemStart.push_back(pieces.size());
+
+    long long items = itemStart.size() - 1;
+    vector<BatchResult> partial(pieces.size());
+    vector<BatchResult> results(arrays.size());
+
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(dynamic, 1)
+        for (long long w = 0; w < items; ++w)
+            for (size_t p = itemStart[w]; p < itemStart[w + 1]; ++p)
+                partial[p] = reducePiece(arrays[pieces[p].array].data, pieces[p].begin, pieces[p].end);
+
+        #pragma omp for schedule(static)
+        for (long long a = 0; a < (long long)arrays.size(); ++a) {
+            BatchResult r;
+            for (size_t p = firstPiece[a]; p < firstPiece[a + 1]; ++p) {
+                r.minVal = min(r.minVal, partial[p].minVal);
+                r.maxVal = max(r.maxVal, partial[p].maxVal);
+                r.sum += partial[p].sum;
+                r.count += partial[p].count;
+            }
+            r.average = r.count ? static_cast<double>(r.sum) / r.count : 0.0;
+            results[a] = r;
+        }
+    }
+    return results;
+}
+
+// The HPC3 reduction run once per array, each in its own parallel region.
+vector<BatchResult> perArrayReduce(const vector<ArrayRef>& arrays) {
+    vector<BatchResult> results(arrays.size());
+    for (size_t a = 0; a < arrays.size(); ++a) {
+        const int* data = arrays[a].data;
+        long long n = arrays[a].size;
+        int minVal = INT_MAX, maxVal = INT_MIN;
+        long long sum = 0;
+
+        #pragma omp parallel for reduction(min:minVal) reduction(max:maxVal) reduction(+:sum)
+        for (long long i = 0; i < n; ++i) {
+            if (data[i] < minVal) minVal = data[i];
+            if (data[i] > maxVal) maxVal = data[i];
+            sum += data[i];
+        }
+
+        results[a].minVal = minVal;
+        results[a].maxVal = maxVal;
+        results[a].sum = sum;
+        results[a].count = n;
+        results[a].average = n ? static_cast<double>(sum) / n : 0.0;
+    }
+    return results;
+}
+
+bool sameResults(const vector<BatchResult>& a, const vector<BatchResult>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (a[i].minVal != b[i].minVal || a[i].maxVal != b[i].maxVal || a[i].sum != b[i].sum || a[i].count != b[i].count)
+            return false;
+    return true;
+}
+
+int main() {
+    const int POOL = 100000000;
+    const int ARRAYS = 50000;
+    const int REPEATS = 5;
+    const uint64_t SEED = 2024;
+    vector<int> pool(POOL);
+    fillUniformInt(pool, 0, 9999, SEED);
+
+    // Array lengths are log-uniform from 16 to 4096, with one array in fifty
+    // drawn up to 4M instead; each array is a slice of the pool.
+    vector<ArrayRef> arrays(ARRAYS);
+    long long totalElements = 0;
+    for (int a = 0; a < ARRAYS; ++a) {
+        uint64_t r = SplitMix64::bits(SEED, a);
+        int maxBits = toBounded(r, 50) == 0 ? 22 : 12;
+        double bits = 4 + (maxBits - 4) * toUnitDouble(SplitMix64::bits(SEED + 1, a));
+        long long size = (long long)exp2(bits);
+        long long offset = toBounded(SplitMix64::bits(SEED + 2, a), POOL - size);
+        arrays[a] = {pool.data() + offset, size};
+        totalElements += size;
+    }
+
+    vector<BatchResult> expected, batched;
+
+    auto start = high_resolution_clock::now();
+    for (int k = 0; k < REPEATS; ++k)
+        expected = perArrayReduce(arrays);
+    auto end = high_resolution_clock::now();
+    double perArrayTime = duration<double>(end - start).count() / REPEATS;
+
+    start = high_resolution_clock::now();
+    for (int k = 0; k < REPEATS; ++k)
+        batched = batchedReduce(arrays);
+    end = high_resolution_clock::now();
+    double batchedTime = duration<double>(end - start).count() / REPEATS;
+
+    double bytes = (double)totalElements * sizeof(int);
+    cout << "Arrays: " << ARRAYS << ", Elements: " << totalElements << "\n";
+    cout << "Per-Array Regions: " << perArrayTime * 1000 << " ms (" << ARRAYS / perArrayTime << " arrays/s, "
+         << bytes / perArrayTime / 1e9 << " GB/s)\n";
+    cout << "Batched: " << batchedTime * 1000 << " ms (" << ARRAYS / batchedTime << " arrays/s, "
+         << bytes / batchedTime / 1e9 << " GB/s)\n";
+    cout << "First Array: Min " << batched[0].minVal << ", Max " << batched[0].maxVal << ", Sum "
+         << batched[0].sum << ", Average " << batched[0].average << "\n";
+    cout << "Correct: " << (sameResults(expected, batched) ? "yes" : "no") << "\n";
+
+    return 0;
+}
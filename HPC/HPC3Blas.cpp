@@ -0,0 +1,297 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <omp.h>
+#include "ParallelRandom.h"
+#include "PairwiseTree.h"
+
+using namespace std;
+using namespace chrono;
+
+// Blocks are the unit of work and, in deterministic mode, of summation order:
+// block partials are combined by a fixed pairwise tree as in
+// HPC3DeterministicSum.cpp (PairwiseTree.h), so the bits of every result are independent of the
+// thread count. The fast mode combines per-thread partials instead.
+const long long BLAS_BLOCK = 4096;
+
+// Independent accumulators per block: four 512-bit registers' worth, so each
+// add chain has time to retire before its accumulator is needed again.
+template <typename T>
+struct Lanes {
+    static const int COUNT = 4 * 64 / sizeof(T);
+};
+
+template <typename Partial, typename BlockFn>
+Partial blockedReduce(long long n, BlockFn blockFn, bool deterministic) {
+    long long blocks = (n + BLAS_BLOCK - 1) / BLAS_BLOCK;
+
+    if (deterministic) {
+        vector<Partial> partial(blocks);
+        #pragma omp parallel for schedule(static)
+        for (long long b = 0; b < blocks; ++b)
+            partial[b] = blockFn(b * BLAS_BLOCK, min(BLAS_BLOCK, n - b * BLAS_BLOCK));
+        return pairwiseTree(partial, [](const Partial& a, const Partial& c) { return a + c; });
+    }
+
+    Partial total = Partial();
+    #pragma omp parallel
+    {
+        Partial local = Partial();
+        #pragma omp for schedule(static) nowait
+        for (long long b = 0; b < blocks; ++b)
+            local = local + blockFn(b * BLAS_BLOCK, min(BLAS_BLOCK, n - b * BLAS_BLOCK));
+        #pragma omp critical
+        total = total + local;
+    }
+    return total;
+}
+
+// Folds the lanes of a block accumulator by a fixed tree, in double.
+template <typename T>
+double foldLanes(const T* acc) {
+    double lane[Lanes<T>::COUNT];
+    for (int l = 0; l < Lanes<T>::COUNT; ++l)
+        lane[l] = acc[l];
+    for (int w = Lanes<T>::COUNT / 2; w > 0; w /= 2)
+        for (int l = 0; l < w; ++l)
+            lane[l] += lane[l + w];
+    return lane[0];
+}
+
+struct Sum {
+    double value = 0.0;
+    Sum operator+(const Sum& o) const { return {value + o.value}; }
+};
+
+struct Max {
+    double value = 0.0;
+    Max operator+(const Max& o) const { return {max(value, o.value)}; }
+};
+
+struct DotNorms {
+    double dot = 0.0;
+    double xx = 0.0;
+    double yy = 0.0;
+    DotNorms operator+(const DotNorms& o) const { return {dot + o.dot, xx + o.xx, yy + o.yy}; }
+};
+
+template <typename T>
+double dot(const vector<T>& x, const vector<T>& y, bool deterministic = false) {
+    const int L = Lanes<T>::COUNT;
+    const T* px = x.data();
+    const T* py = y.data();
+    return blockedReduce<Sum>(x.size(), [=](long long begin, long long len) {
+        T acc[L] = {};
+        long long i = 0;
+        for (; i + L <= len; i += L) {
+            #pragma omp simd
+            for (int l = 0; l < L; ++l)
+                acc[l] += px[begin + i + l] * py[begin + i + l];
+        }
+        for (; i < len; ++i)
+            acc[i % L] += px[begin + i] * py[begin + i];
+        return Sum{foldLanes(acc)};
+    }, deterministic).value;
+}
+
+template <typename T>
+double asum(const vector<T>& x, bool deterministic = false) {
+    const int L = Lanes<T>::COUNT;
+    const T* px = x.data();
+    return blockedReduce<Sum>(x.size(), [=](long long begin, long long len) {
+        T acc[L] = {};
+        long long i = 0;
+        for (; i + L <= len; i += L) {
+            #pragma omp simd
+            for (int l = 0; l < L; ++l)
+                acc[l] += fabs(px[begin + i + l]);
+        }
+        for (; i < len; ++i)
+            acc[i % L] += fabs(px[begin + i]);
+        return Sum{foldLanes(acc)};
+    }, deterministic).value;
+}
+
+// Sums squares without the rescaling reference BLAS does, so elements beyond
+// the square root of the type's largest value overflow; for float the block
+// partials are widened to double before they are combined.
+template <typename T>
+double nrm2(const vector<T>& x, bool deterministic = false) {
+    const int L = Lanes<T>::COUNT;
+    const T* px = x.data();
+    return sqrt(blockedReduce<Sum>(x.size(), [=](long long begin, long long len) {
+        T acc[L] = {};
+        long long i = 0;
+        for (; i + L <= len; i += L) {
+            #pragma omp simd
+            for (int l = 0; l < L; ++l)
+                acc[l] += px[begin + i + l] * px[begin + i + l];
+        }
+        for (; i < len; ++i)
+            acc[i % L] += px[begin + i] * px[begin + i];
+        return Sum{foldLanes(acc)};
+    }, deterministic).value);
+}
+
+// The maximum is exact, so there is no deterministic variant to ask for.
+template <typename T>
+double amax(const vector<T>& x) {
+    const int L = Lanes<T>::COUNT;
+    const T* px = x.data();
+    return blockedReduce<Max>(x.size(), [=](long long begin, long long len) {
+        T acc[L] = {};
+        long long i = 0;
+        for (; i + L <= len; i += L) {
+            #pragma omp simd
+            for (int l = 0; l < L; ++l)
+                acc[l] = max(acc[l], (T)fabs(px[begin + i + l]));
+        }
+        for (; i < len; ++i)
+            acc[i % L] = max(acc[i % L], (T)fabs(px[begin + i]));
+        return Max{*max_element(acc, acc + L)};
+    }, false).value;
+}
+
+// x.y, x.x and y.y in one pass, e.g. for the cosine of two vectors; reads x and
+// y once instead of the four reads of dot followed by two nrm2 calls.
+template <typename T>
+DotNorms dotNorms(const vector<T>& x, const vector<T>& y, bool deterministic = false) {
+    const int L = Lanes<T>::COUNT;
+    const T* px = x.data();
+    const T* py = y.data();
+    return blockedReduce<DotNorms>(x.size(), [=](long long begin, long long len) {
+        T xy[L] = {}, xx[L] = {}, yy[L] = {};
+        long long i = 0;
+        for (; i + L <= len; i += L) {
+            #pragma omp simd
+            for (int l = 0; l < L; ++l) {
+                T a = px[begin + i + l], b = py[begin + i + l];
+                xy[l] += a * b;
+                xx[l] += a * a;
+                yy[l] += b * b;
+            }
+        }
+        for (; i < len; ++i) {
+            T a = px[begin + i], b = py[begin + i];
+            xy[i % L] += a * b;
+            xx[i % L] += a * a;
+            yy[i % L] += b * b;
+        }
+        return DotNorms{foldLanes(xy), foldLanes(xx), foldLanes(yy)};
+    }, deterministic);
+}
+
+// y = a * x + y
+template <typename T>
+void axpy(T a, const vector<T>& x, vector<T>& y) {
+    long long n = x.size();
+    const T* px = x.data();
+    T* py = y.data();
+    #pragma omp parallel for simd schedule(static)
+    for (long long i = 0; i < n; ++i)
+        py[i] += a * px[i];
+}
+
+// STREAM triad a = b + s * c, counted as three arrays of traffic like STREAM does.
+double streamTriadBandwidth(long long n) {
+    vector<double> a(n), b(n), c(n);
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < n; ++i) {
+        a[i] = 0.0;
+        b[i] = 1.0;
+        c[i] = 2.0;
+    }
+
+    double best = 1e30;
+    for (int k = 0; k < 5; ++k) {
+        auto start = high_resolution_clock::now();
+        #pragma omp parallel for simd schedule(static)
+        for (long long i = 0; i < n; ++i)
+            a[i] = b[i] + 3.0 * c[i];
+        auto end = high_resolution_clock::now();
+        best = min(best, duration<double>(end - start).count());
+    }
+    return 3.0 * sizeof(double) * n / best / 1e9;
+}
+
+template <typename F>
+double bestSeconds(F f) {
+    double best = 1e30;
+    for (int k = 0; k < 5; ++k) {
+        auto start = high_resolution_clock::now();
+        f();
+        auto end = high_resolution_clock::now();
+        best = min(best, duration<double>(end - start).count());
+    }
+    return best;
+}
+
+template <typename T>
+void runSuite(const char* label, long long n, double stream, uint64_t seed) {
+    vector<double> source(n);
+    vector<T> x(n), y(n);
+    fillUniformReal(source, -1.0, 1.0, seed);
+    copy(source.begin(), source.end(), x.begin());
+    fillUniformReal(source, -1.0, 1.0, seed + 1);
+    copy(source.begin(), source.end(), y.begin());
+    vector<double>().swap(source);
+
+    double bytes = (double)n * sizeof(T);
+    auto report = [&](const char* kernel, double traffic, double seconds, double value) {
+        double rate = traffic / seconds / 1e9;
+        cout << "  " << kernel << ": " << value << " | " << seconds * 1000 << " ms, " << rate << " GB/s ("
+             << rate / stream * 100 << "% of STREAM)\n";
+    };
+
+    double d = 0, dd = 0, l1 = 0, l2 = 0, linf = 0;
+    DotNorms fused;
+    cout << label << ", n = " << n << ":\n";
+    double t = bestSeconds([&] { d = dot(x, y); });
+    report("dot", 2 * bytes, t, d);
+    t = bestSeconds([&] { dd = dot(x, y, true); });
+    report("dot (deterministic)", 2 * bytes, t, dd);
+    t = bestSeconds([&] { l1 = asum(x); });
+    report("L1 norm", bytes, t, l1);
+    t = bestSeconds([&] { l2 = nrm2(x); });
+    report("L2 norm", bytes, t, l2);
+    t = bestSeconds([&] { linf = amax(x); });
+    report("Linf norm", bytes, t, linf);
+    t = bestSeconds([&] { fused = dotNorms(x, y); });
+    report("dot + norms fused", 2 * bytes, t, fused.dot);
+    t = bestSeconds([&] { dot(x, y); nrm2(x); nrm2(y); });
+    cout << "  dot + 2 x nrm2 separately: " << t * 1000 << " ms\n";
+    t = bestSeconds([&] { axpy((T)1e-3, x, y); });
+    report("axpy", 3 * bytes, t, y[0]);
+
+    long double reference = 0;
+    for (long long i = 0; i < n; ++i)
+        reference += (long double)x[i] * y[i];
+    double exact = dot(x, y, true);
+    DotNorms exactFused = dotNorms(x, y, true);
+    cout << "  Relative error of dot vs long double: " << fabs((double)((exact - reference) / reference)) << "\n";
+
+    bool same = true;
+    int threads = omp_get_max_threads();
+    for (int t : {1, 3, threads}) {
+        omp_set_num_threads(t);
+        DotNorms f = dotNorms(x, y, true);
+        same = same && dot(x, y, true) == exact && f.dot == exactFused.dot && f.xx == exactFused.xx && f.yy == exactFused.yy;
+    }
+    omp_set_num_threads(threads);
+    cout << "  Deterministic across thread counts: " << (same ? "yes" : "no") << "\n";
+}
+
+int main() {
+    const long long SIZE = 1 << 25;
+    const uint64_t SEED = 2024;
+
+    double stream = streamTriadBandwidth(SIZE);
+    cout << "STREAM Triad Bandwidth: " << stream << " GB/s\n";
+
+    runSuite<double>("double", SIZE, stream, SEED);
+    runSuite<float>("float", SIZE, stream, SEED);
+
+    return 0;
+}
@@ -1,32 +1,57 @@
 #include <iostream>
 #include <vector>
-#include <cstdlib>
-#include <ctime>
-#include <omp.h>
+#include <algorithm>
+#include "ParallelRandom.h" // Counter-based parallel random generation
+#include "ThreadPool.h"     // Persistent work-stealing thread pool
+#include "PerfCounters.h"   // Per-thread hardware counters via perf_event_open
 
 using namespace std;
 
+// Partial result of one piece of the array
+struct MinMaxSum {
+    int minVal;
+    int maxVal;
+    long long sum;
+};
+
 int main() {
     const int SIZE = 1000000; // Define the size of the vector
+    const int GRAIN = 1 << 14; // Elements per piece handed to a pool thread
+    const uint64_t SEED = 2024; // Same seed gives the same data at any thread count
     vector<int> data(SIZE);  // Create a vector to store the data
 
     // Fill vector with random integers
-    srand(time(0)); // Seed for random number generation
-    for (int i = 0; i < SIZE; ++i) {
-        data[i] = rand() % 10000; // Fill the vector with random numbers between 0 and 9999
-    }
-
-    int minVal = data[0]; // Initialize min value to the first element
-    int maxVal = data[0]; // Initialize max value to the first element
-    long long sum = 0;    // Initialize sum to 0
-
-    // Parallel Reduction
-    #pragma omp parallel for reduction(min:minVal) reduction(max:maxVal) reduction(+:sum)
-    for (int i = 0; i < SIZE; ++i) {
-        if (data[i] < minVal) minVal = data[i]; // Find minimum value
-        if (data[i] > maxVal) maxVal = data[i]; // Find maximum value
-        sum += data[i]; // Add value to sum
-    }
+    fillUniformInt(data, 0, 9999, SEED); // Random numbers between 0 and 9999, generated in parallel
+
+    // Start from the first element for min/max and 0 for the sum
+    MinMaxSum identity = {data[0], data[0], 0};
+
+    // Start the pool's threads and park them, so a worker is only counted
+    // if it wakes for one of the kernel's tasks
+    ThreadPool::global().park();
+
+    // Parallel Reduction on the pool, under per-thread counters: each piece is
+    // reduced on its own, then partial results are combined pairwise
+    MinMaxSum total;
+    KernelCounters counters = countKernel("Parallel Reduction", SIZE, [&] {
+        total = parallelReduce(0, SIZE, GRAIN, identity,
+            [&](long long lo, long long hi) {
+                MinMaxSum r = identity;
+                for (long long i = lo; i < hi; ++i) {
+                    if (data[i] < r.minVal) r.minVal = data[i]; // Find minimum value
+                    if (data[i] > r.maxVal) r.maxVal = data[i]; // Find maximum value
+                    r.sum += data[i]; // Add value to sum
+                }
+                return r;
+            },
+            [](const MinMaxSum& a, const MinMaxSum& b) { // Combine two partial results
+                return MinMaxSum{min(a.minVal, b.minVal), max(a.maxVal, b.maxVal), a.sum + b.sum};
+            });
+    });
+
+    int minVal = total.minVal;  // Minimum over all pieces
+    int maxVal = total.maxVal;  // Maximum over all pieces
+    long long sum = total.sum;  // Sum over all pieces
 
     double average = static_cast<double>(sum) / SIZE; // Calculate average
 
@@ -36,6 +61,7 @@ int main() {
     cout << "Max: " << maxVal << "\n";   // Print the maximum value
     cout << "Sum: " << sum << "\n";      // Print the sum of the values
     cout << "Average: " << average << "\n"; // Print the average
+    printCounters(counters); // IPC and misses per element of the reduction
 
     return 0;
 }
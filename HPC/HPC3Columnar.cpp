@@ -0,0 +1,169 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+#include <omp.h>
+#include "ParallelRandom.h"
+
+using namespace std;
+using namespace chrono;
+
+enum AggregateFlags : unsigned {
+    AGG_MIN = 1,
+    AGG_MAX = 2,
+    AGG_SUM = 4,
+    AGG_MEAN = 8,
+    AGG_ALL = AGG_MIN | AGG_MAX | AGG_SUM | AGG_MEAN
+};
+
+struct ColumnSpec {
+    string name;
+    const int* data;
+    unsigned aggregates;
+};
+
+struct ColumnResult {
+    int minVal = INT_MAX;
+    int maxVal = INT_MIN;
+    long long sum = 0;
+    long long count = 0;
+    double mean = 0.0;
+};
+
+struct NoFilter {
+    bool operator()(long long) const { return true; }
+};
+
+// Rows are swept in blocks small enough that one block of every column stays
+// in L2 together. The filter runs once per row into a block mask, and every
+// column then reduces its block under that mask with branch-free SIMD selects.
+template <typename Filter = NoFilter>
+vector<ColumnResult> fusedColumnReduce(const vector<ColumnSpec>& columns, long long rows,
+                                       Filter filter = Filter(), size_t cacheBytes = 256 * 1024) {
+    int ncols = columns.size();
+    long long block = cacheBytes / (sizeof(int) * max(ncols, 1));
+    block = max<long long>(64, block / 64 * 64);
+    long long blocks = (rows + block - 1) / block;
+    vector<ColumnResult> results(ncols);
+
+    #pragma omp parallel
+    {
+        vector<ColumnResult> local(ncols);
+        vector<uint8_t> mask(block);
+
+        #pragma omp for schedule(static) nowait
+        for (long long b = 0; b < blocks; ++b) {
+            long long begin = b * block;
+            long long len = min(block, rows - begin);
+
+            long long selected = 0;
+            for (long long i = 0; i < len; ++i) {
+                mask[i] = filter(begin + i);
+                selected += mask[i];
+            }
+            if (selected == 0) continue;
+
+            for (int c = 0; c < ncols; ++c) {
+                const int* col = columns[c].data + begin;
+                unsigned want = columns[c].aggregates;
+                int minVal = INT_MAX, maxVal = INT_MIN;
+                long long sum = 0;
+
+                if (want & (AGG_MIN | AGG_MAX)) {
+                    #pragma omp simd reduction(min:minVal) reduction(max:maxVal)
+                    for (long long i = 0; i < len; ++i) {
+                        minVal = min(minVal, mask[i] ? col[i] : INT_MAX);
+                        maxVal = max(maxVal, mask[i] ? col[i] : INT_MIN);
+                    }
+                }
+                if (want & (AGG_SUM | AGG_MEAN)) {
+                    #pragma omp simd reduction(+:sum)
+                    for (long long i = 0; i < len; ++i)
+                        sum += mask[i] ? col[i] : 0;
+                }
+
+                local[c].minVal = min(local[c].minVal, minVal);
+                local[c].maxVal = max(local[c].maxVal, maxVal);
+                local[c].sum += sum;
+                local[c].count += selected;
+            }
+        }
+
+        #pragma omp critical
+        for (int c = 0; c < ncols; ++c) {
+            results[c].minVal = min(results[c].minVal, local[c].minVal);
+            results[c].maxVal = max(results[c].maxVal, local[c].maxVal);
+            results[c].sum += local[c].sum;
+            results[c].count += local[c].count;
+        }
+    }
+
+    for (ColumnResult& r : results)
+        r.mean = r.count ? static_cast<double>(r.sum) / r.count : 0.0;
+    return results;
+}
+
+// One HPC3-style loop per column, re-evaluating the filter each time.
+template <typename Filter>
+vector<ColumnResult> perColumnReduce(const vector<ColumnSpec>& columns, long long rows, Filter filter) {
+    vector<ColumnResult> results(columns.size());
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const int* col = columns[c].data;
+        int minVal = INT_MAX, maxVal = INT_MIN;
+        long long sum = 0, count = 0;
+
+        #pragma omp parallel for reduction(min:minVal) reduction(max:maxVal) reduction(+:sum, count)
+        for (long long i = 0; i < rows; ++i) {
+            if (!filter(i)) continue;
+            if (col[i] < minVal) minVal = col[i];
+            if (col[i] > maxVal) maxVal = col[i];
+            sum += col[i];
+            ++count;
+        }
+        results[c] = {minVal, maxVal, sum, count, count ? static_cast<double>(sum) / count : 0.0};
+    }
+    return results;
+}
+
+int main() {
+    const int ROWS = 10000000;
+    const int COLUMNS = 12;
+    const uint64_t SEED = 2024;
+    vector<vector<int>> table(COLUMNS, vector<int>(ROWS));
+    vector<ColumnSpec> columns;
+
+    for (int c = 0; c < COLUMNS; ++c) {
+        fillUniformInt(table[c], 0, 9999, SEED + c);
+        columns.push_back({"c" + to_string(c), table[c].data(), AGG_ALL});
+    }
+
+    const int* status = table[0].data();
+    const int* region = table[1].data();
+    auto filter = [=](long long row) { return status[row] > 5000 && region[row] % 4 == 1; };
+
+    auto start = high_resolution_clock::now();
+    vector<ColumnResult> separate = perColumnReduce(columns, ROWS, filter);
+    auto end = high_resolution_clock::now();
+    cout << "Per-Column Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+
+    start = high_resolution_clock::now();
+    vector<ColumnResult> fused = fusedColumnReduce(columns, ROWS, filter);
+    end = high_resolution_clock::now();
+    cout << "Fused Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+
+    bool ok = true;
+    for (int c = 0; c < COLUMNS; ++c)
+        ok = ok && fused[c].minVal == separate[c].minVal && fused[c].maxVal == separate[c].maxVal &&
+             fused[c].sum == separate[c].sum && fused[c].count == separate[c].count;
+
+    cout << "Filtered Rows: " << fused[0].count << "\n";
+    for (int c = 0; c < 3; ++c)
+        cout << columns[c].name << " Min: " << fused[c].minVal << ", Max: " << fused[c].maxVal
+             << ", Sum: " << fused[c].sum << ", Average: " << fused[c].mean << "\n";
+    cout << "Correct: " << (ok ? "yes" : "no") << "\n";
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+#include <immintrin.h>
+#include <omp.h>
+#include "ParallelRandom.h"
+#include "RangePredicate.h"
+#include "ParallelScan.h"
+
+using namespace std;
+using namespace chrono;
+
+// Writes every element and advances only past the selected ones, so the loop
+// has no data-dependent branch. A write that would land past the block's
+// `capacity` selected elements goes to a dummy slot instead, so the kernel
+// never touches another block's output.
+template <typename Pred>
+size_t compactBlockScalar(const int* in, size_t n, int* out, size_t capacity, Pred pred) {
+    size_t k = 0;
+    int discard;
+    for (size_t i = 0; i < n; ++i) {
+        int* slot = k < capacity ? out + k : &discard;
+        *slot = in[i];
+        k += pred(in[i]);
+    }
+    return k;
+}
+
+#if defined(__AVX2__) && !defined(__AVX512F__)
+// permutations[m] moves the lanes selected by bit mask m to the front.
+struct PermutationTable {
+    alignas(32) int32_t lanes[256][8];
+    PermutationTable() {
+        for (int m = 0; m < 256; ++m) {
+            int k = 0;
+            for (int lane = 0; lane < 8; ++lane)
+                if (m & (1 << lane)) lanes[m][k++] = lane;
+            while (k < 8) lanes[m][k++] = 0;
+        }
+    }
+};
+static const PermutationTable permutations;
+#endif
+
+// Writes exactly the selected elements, never past them, because neighbouring
+// blocks write to adjacent ranges of the output concurrently.
+size_t compactBlock(const int* in, size_t n, int* out, InRange pred) {
+    size_t k = 0, i = 0;
+#if defined(__AVX512F__)
+    __m512i lo = _mm512_set1_epi32(pred.lo), hi = _mm512_set1_epi32(pred.hi);
+    for (; i + 16 <= n; i += 16) {
+        __m512i v = _mm512_loadu_si512(in + i);
+        __mmask16 m = _mm512_cmpge_epi32_mask(v, lo) & _mm512_cmple_epi32_mask(v, hi);
+        _mm512_mask_compressstoreu_epi32(out + k, m, v);
+        k += __builtin_popcount(m);
+    }
+#elif defined(__AVX2__)
+    __m256i lo = _mm256_set1_epi32(pred.lo), hi = _mm256_set1_epi32(pred.hi);
+    __m256i laneIndex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(in + i));
+        __m256i reject = _mm256_or_si256(_mm256_cmpgt_epi32(lo, v), _mm256_cmpgt_epi32(v, hi));
+        int m = ~_mm256_movemask_ps(_mm256_castsi256_ps(reject)) & 0xFF;
+        int count = __builtin_popcount(m);
+        __m256i packed = _mm256_permutevar8x32_epi32(v, _mm256_load_si256((const __m256i*)permutations.lanes[m]));
+        __m256i storeMask = _mm256_cmpgt_epi32(_mm256_set1_epi32(count), laneIndex);
+        _mm256_maskstore_epi32(out + k, storeMask, packed);
+        k += count;
+    }
+#endif
+    for (; i < n; ++i)
+        if (pred(in[i])) out[k++] = in[i];
+    return k;
+}
+
+const size_t COMPACT_BLOCK = 1 << 14;
+
+// Counts the selected elements of each block and exclusive-scans the counts
+// into output offsets. Returns the total.
+template <typename Pred>
+long long blockOffsets(const vector<int>& in, Pred pred, vector<long long>& offsets) {
+    long long n = in.size();
+    long long blocks = (n + COMPACT_BLOCK - 1) / COMPACT_BLOCK;
+    vector<long long> counts(blocks);
+
+    #pragma omp parallel for schedule(static)
+    for (long long b = 0; b < blocks; ++b) {
+        const int* block = in.data() + b * COMPACT_BLOCK;
+        long long len = min<long long>(COMPACT_BLOCK, n - b * COMPACT_BLOCK);
+        long long count = 0;
+        for (long long i = 0; i < len; ++i)
+            count += pred(block[i]);
+        counts[b] = count;
+    }
+
+    exclusiveScan(counts, offsets);
+    return blocks ? offsets.back() + counts.back() : 0;
+}
+
+void parallelCompact(const vector<int>& in, vector<int>& out, InRange pred) {
+    long long n = in.size();
+    long long blocks = (n + COMPACT_BLOCK - 1) / COMPACT_BLOCK;
+    vector<long long> offsets;
+    out.resize(blockOffsets(in, pred, offsets));
+
+    #pragma omp parallel for schedule(static)
+    for (long long b = 0; b < blocks; ++b) {
+        long long len = min<long long>(COMPACT_BLOCK, n - b * COMPACT_BLOCK);
+        compactBlock(in.data() + b * COMPACT_BLOCK, len, out.data() + offsets[b], pred);
+    }
+}
+
+// Any predicate, through the branch-free scalar kernel. Each block's capacity
+// is its selected count, so blocks are independent.
+template <typename Pred>
+void parallelCopyIf(const vector<int>& in, vector<int>& out, Pred pred) {
+    long long n = in.size();
+    long long blocks = (n + COMPACT_BLOCK - 1) / COMPACT_BLOCK;
+    vector<long long> offsets;
+    long long total = blockOffsets(in, pred, offsets);
+    out.resize(total);
+
+    #pragma omp parallel for schedule(static)
+    for (long long b = 0; b < blocks; ++b) {
+        long long len = min<long long>(COMPACT_BLOCK, n - b * COMPACT_BLOCK);
+        long long capacity = (b + 1 < blocks ? offsets[b + 1] : total) - offsets[b];
+        compactBlockScalar(in.data() + b * COMPACT_BLOCK, len, out.data() + offsets[b], capacity, pred);
+    }
+}
+
+int main() {
+    const int SIZE = 100000000;
+    const uint64_t SEED = 2024;
+    const InRange PREDICATES[] = {{0, 999}, {5000, INT_MAX}};
+    vector<int> data(SIZE);
+
+    fillUniformInt(data, 0, 9999, SEED);
+
+#if defined(__AVX512F__)
+    cout << "Compaction Kernel: AVX-512 compress-store\n";
+#elif defined(__AVX2__)
+    cout << "Compaction Kernel: AVX2 shuffle table\n";
+#else
+    cout << "Compaction Kernel: scalar\n";
+#endif
+
+    for (InRange pred : PREDICATES) {
+        vector<int> expected, simd, generic;
+        expected.reserve(SIZE);
+
+        auto start = high_resolution_clock::now();
+        copy_if(data.begin(), data.end(), back_inserter(expected), pred);
+        auto end = high_resolution_clock::now();
+        long long seqTime = duration_cast<milliseconds>(end - start).count();
+
+        start = high_resolution_clock::now();
+        parallelCompact(data, simd, pred);
+        end = high_resolution_clock::now();
+        long long simdTime = duration_cast<milliseconds>(end - start).count();
+
+        start = high_resolution_clock::now();
+        parallelCopyIf(data, generic, [=](int x) { return pred(x); });
+        end = high_resolution_clock::now();
+        long long genericTime = duration_cast<milliseconds>(end - start).count();
+
+        start = high_resolution_clock::now();
+        long long materializedSum = 0;
+        vector<int> selected;
+        parallelCompact(data, selected, pred);
+        #pragma omp parallel for reduction(+:materializedSum)
+        for (long long i = 0; i < (long long)selected.size(); ++i)
+            materializedSum += selected[i];
+        end = high_resolution_clock::now();
+        long long materializedTime = duration_cast<milliseconds>(end - start).count();
+
+        start = high_resolution_clock::now();
+        FilteredStats stats = filteredReduce(data, pred);
+        end = high_resolution_clock::now();
+        long long fusedTime = duration_cast<milliseconds>(end - start).count();
+
+        bool ok = simd == expected && generic == expected && stats.sum == materializedSum &&
+                  stats.count == (long long)expected.size();
+
+        cout << "Predicate [" << pred.lo << ", " << pred.hi << "]: " << expected.size() << " selected\n";
+        cout << "  std::copy_if Time: " << seqTime << " ms\n";
+        cout << "  SIMD Compaction Time: " << simdTime << " ms\n";
+        cout << "  Generic Compaction Time: " << genericTime << " ms\n";
+        cout << "  Compact + Sum Time: " << materializedTime << " ms\n";
+        cout << "  Fused Filtered Reduction Time: " << fusedTime << " ms (Min " << stats.minVal
+             << ", Max " << stats.maxVal << ", Sum " << stats.sum << ")\n";
+        cout << "  Correct: " << (ok ? "yes" : "no") << "\n";
+    }
+
+    // Only the first half of block 0 is selected and the trailing blocks are
+    // empty, so no block may write past its own share of the output.
+    vector<int> sparse(3 * COMPACT_BLOCK, 1);
+    fill(sparse.begin(), sparse.begin() + COMPACT_BLOCK / 2, 0);
+    InRange zero = {0, 0};
+    vector<int> expected, simd, generic;
+    copy_if(sparse.begin(), sparse.end(), back_inserter(expected), zero);
+    parallelCompact(sparse, simd, zero);
+    parallelCopyIf(sparse, generic, [=](int x) { return zero(x); });
+    cout << "Trailing Empty Blocks Correct: " << (simd == expected && generic == expected ? "yes" : "no") << "\n";
+
+    return 0;
+}
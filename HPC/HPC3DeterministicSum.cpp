@@ -0,0 +1,157 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <omp.h>
+#include "ParallelRandom.h"
+#include "PairwiseTree.h"
+
+using namespace std;
+using namespace chrono;
+
+// The shape of the summation tree depends only on the array length: blocks have
+// a fixed size, lanes inside a block are fixed, and block sums are combined by a
+// fixed pairwise tree. Threads only decide who computes which block, so the bits
+// of the result never depend on the thread count or the schedule.
+const int BLOCK = 4096;
+const int LANES = 8;
+
+struct CompensatedSum {
+    double sum;
+    double comp;
+};
+
+inline CompensatedSum combine(CompensatedSum a, CompensatedSum b) {
+    double s = a.sum + b.sum;
+    double bb = s - a.sum;
+    double err = (a.sum - (s - bb)) + (b.sum - bb);
+    return {s, a.comp + b.comp + err};
+}
+
+double blockSum(const double* x, int n) {
+    double lane[LANES] = {0};
+    int i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        #pragma omp simd
+        for (int l = 0; l < LANES; ++l)
+            lane[l] += x[i + l];
+    }
+    for (; i < n; ++i)
+        lane[i % LANES] += x[i];
+    for (int w = LANES / 2; w > 0; w /= 2)
+        for (int l = 0; l < w; ++l)
+            lane[l] += lane[l + w];
+    return lane[0];
+}
+
+// Neumaier summation per lane: the correction term also captures the case where
+// the incoming value is larger than the running sum.
+CompensatedSum blockSumCompensated(const double* x, int n) {
+    double s[LANES] = {0};
+    double c[LANES] = {0};
+    int i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        #pragma omp simd
+        for (int l = 0; l < LANES; ++l) {
+            double v = x[i + l];
+            double t = s[l] + v;
+            c[l] += fabs(s[l]) >= fabs(v) ? (s[l] - t) + v : (v - t) + s[l];
+            s[l] = t;
+        }
+    }
+    CompensatedSum lane[LANES];
+    for (int l = 0; l < LANES; ++l)
+        lane[l] = {s[l], c[l]};
+    for (; i < n; ++i)
+        lane[i % LANES] = combine(lane[i % LANES], {x[i], 0.0});
+    for (int w = LANES / 2; w > 0; w /= 2)
+        for (int l = 0; l < w; ++l)
+            lane[l] = combine(lane[l], lane[l + w]);
+    return lane[0];
+}
+
+double deterministicSum(const vector<double>& data, bool compensated = false) {
+    long long n = data.size();
+    if (n == 0) return 0.0;
+    long long blocks = (n + BLOCK - 1) / BLOCK;
+
+    if (!compensated) {
+        vector<double> partial(blocks);
+        #pragma omp parallel for schedule(static)
+        for (long long b = 0; b < blocks; ++b)
+            partial[b] = blockSum(data.data() + b * BLOCK, min<long long>(BLOCK, n - b * BLOCK));
+        return pairwiseTree(partial, [](double a, double b) { return a + b; });
+    }
+
+    vector<CompensatedSum> partial(blocks);
+    #pragma omp parallel for schedule(static)
+    for (long long b = 0; b < blocks; ++b)
+        partial[b] = blockSumCompensated(data.data() + b * BLOCK, min<long long>(BLOCK, n - b * BLOCK));
+    CompensatedSum total = pairwiseTree(partial, combine);
+    return total.sum + total.comp;
+}
+
+double ompReductionSum(const vector<double>& data) {
+    double sum = 0.0;
+    #pragma omp parallel for reduction(+:sum)
+    for (long long i = 0; i < (long long)data.size(); ++i)
+        sum += data[i];
+    return sum;
+}
+
+bool sameBits(double a, double b) {
+    return memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+int main() {
+    const int SIZE = 20000000;
+    const int THREAD_COUNTS[] = {1, 2, 3, 4, 7, 8};
+    const uint64_t SEED = 2024;
+    vector<double> data(SIZE);
+
+    vector<int> exponent(SIZE);
+    fillUniformReal(data, -1.0, 1.0, SEED);
+    fillUniformInt(exponent, -8, 7, SEED + 1);
+    for (int i = 0; i < SIZE; ++i)
+        data[i] *= pow(10.0, exponent[i]);
+
+    double firstPairwise = 0.0, firstCompensated = 0.0;
+    bool same = true;
+
+    cout << hexfloat;
+    cout << "Deterministic Reduction Results:\n";
+    for (int threads : THREAD_COUNTS) {
+        omp_set_num_threads(threads);
+
+        double naive = ompReductionSum(data);
+
+        auto start = high_resolution_clock::now();
+        double pairwise = deterministicSum(data);
+        auto end = high_resolution_clock::now();
+        double pairwiseTime = duration<double>(end - start).count();
+
+        start = high_resolution_clock::now();
+        double compensated = deterministicSum(data, true);
+        end = high_resolution_clock::now();
+        double compensatedTime = duration<double>(end - start).count();
+
+        if (threads == THREAD_COUNTS[0]) {
+            firstPairwise = pairwise;
+            firstCompensated = compensated;
+        }
+        same = same && sameBits(pairwise, firstPairwise) && sameBits(compensated, firstCompensated);
+
+        double bytes = (double)SIZE * sizeof(double);
+        cout << "Threads: " << threads << "\n";
+        cout << "  OpenMP reduction: " << naive << "\n";
+        cout << "  Pairwise: " << pairwise << defaultfloat
+             << " (" << bytes / pairwiseTime / 1e9 << " GB/s)\n" << hexfloat;
+        cout << "  Compensated: " << compensated << defaultfloat
+             << " (" << bytes / compensatedTime / 1e9 << " GB/s)\n" << hexfloat;
+    }
+    cout << "Deterministic across thread counts: " << (same ? "yes" : "no") << "\n";
+
+    return 0;
+}
@@ -0,0 +1,256 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <omp.h>
+#include "ParallelRandom.h"
+#include "HashPartition.h"
+
+using namespace std;
+using namespace chrono;
+
+struct Aggregate {
+    long long sum = 0;
+    long long count = 0;
+    int minVal = INT_MAX;
+    int maxVal = INT_MIN;
+
+    void add(int v) {
+        sum += v;
+        ++count;
+        minVal = min(minVal, v);
+        maxVal = max(maxVal, v);
+    }
+
+    void merge(const Aggregate& o) {
+        sum += o.sum;
+        count += o.count;
+        minVal = min(minVal, o.minVal);
+        maxVal = max(maxVal, o.maxVal);
+    }
+};
+
+struct GroupEntry {
+    long long key;
+    Aggregate agg;
+};
+
+// Linear-probing table keyed by the low hash bits. Partitioning uses the high
+// bits, so the two never correlate.
+class AggTable {
+public:
+    explicit AggTable(size_t capacity = 1024) { reset(capacity); }
+
+    void reset(size_t capacity) {
+        slots.assign(capacity, GroupEntry());
+        used.assign(capacity, 0);
+        mask = capacity - 1;
+        count = 0;
+    }
+
+    void clear() {
+        fill(used.begin(), used.end(), 0);
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return slots.size(); }
+
+    Aggregate& find(long long key, unsigned long long h) {
+        size_t i = h & mask;
+        while (used[i] && slots[i].key != key)
+            i = (i + 1) & mask;
+        if (!used[i]) {
+            used[i] = 1;
+            slots[i].key = key;
+            slots[i].agg = Aggregate();
+            ++count;
+        }
+        return slots[i].agg;
+    }
+
+    // Global tables grow; thread-local tables are flushed instead.
+    Aggregate& findGrow(long long key, unsigned long long h) {
+        if (2 * (count + 1) > slots.size()) {
+            vector<GroupEntry> oldSlots;
+            vector<char> oldUsed;
+            oldSlots.swap(slots);
+            oldUsed.swap(used);
+            reset(oldSlots.size() * 2);
+            for (size_t i = 0; i < oldSlots.size(); ++i)
+                if (oldUsed[i])
+                    find(oldSlots[i].key, hashKey(oldSlots[i].key)) = oldSlots[i].agg;
+        }
+        return find(key, h);
+    }
+
+    template <typename F>
+    void forEach(F f) const {
+        for (size_t i = 0; i < slots.size(); ++i)
+            if (used[i]) f(slots[i]);
+    }
+
+private:
+    vector<GroupEntry> slots;
+    vector<char> used;
+    size_t mask;
+    size_t count;
+};
+
+enum class GroupByStrategy { Auto, Hash, Sort };
+
+const size_t LOCAL_TABLE_SIZE = 1 << 12;
+const size_t SAMPLE_SIZE = 1 << 16;
+
+// Hash path: pre-aggregate in a cache-resident table per thread, spill it into
+// radix partitions when half full, then merge each partition independently.
+vector<GroupEntry> hashGroupBy(const vector<long long>& keys, const vector<int>& values) {
+    long long n = keys.size();
+    int nthreads = omp_get_max_threads();
+    vector<vector<vector<GroupEntry>>> spills(nthreads, vector<vector<GroupEntry>>(PARTITIONS));
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        auto& mine = spills[omp_get_thread_num()];
+        AggTable local(LOCAL_TABLE_SIZE);
+
+        auto flush = [&]() {
+            local.forEach([&](const GroupEntry& e) {
+                mine[partitionOf(hashKey(e.key))].push_back(e);
+            });
+            local.clear();
+        };
+
+        #pragma omp for schedule(static)
+        for (long long i = 0; i < n; ++i) {
+            if (2 * local.size() >= local.capacity()) flush();
+            local.find(keys[i], hashKey(keys[i])).add(values[i]);
+        }
+        flush();
+    }
+
+    vector<vector<GroupEntry>> results(PARTITIONS);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int p = 0; p < PARTITIONS; ++p) {
+        AggTable global;
+        for (int t = 0; t < nthreads; ++t)
+            for (const GroupEntry& e : spills[t][p])
+                global.findGrow(e.key, hashKey(e.key)).merge(e.agg);
+        global.forEach([&](const GroupEntry& e) { results[p].push_back(e); });
+    }
+
+    vector<GroupEntry> out;
+    for (auto& r : results)
+        out.insert(out.end(), r.begin(), r.end());
+    return out;
+}
+
+// Sort path for very high cardinality, where local tables would spill almost
+// every row: radix-partition the rows, then sort and aggregate runs per partition.
+vector<GroupEntry> sortGroupBy(const vector<long long>& keys, const vector<int>& values) {
+    long long n = keys.size();
+    int nthreads = omp_get_max_threads();
+    vector<vector<vector<pair<long long, int>>>> buckets(nthreads, vector<vector<pair<long long, int>>>(PARTITIONS));
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        auto& mine = buckets[omp_get_thread_num()];
+
+        #pragma omp for schedule(static)
+        for (long long i = 0; i < n; ++i)
+            mine[partitionOf(hashKey(keys[i]))].push_back({keys[i], values[i]});
+    }
+
+    vector<vector<GroupEntry>> results(PARTITIONS);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int p = 0; p < PARTITIONS; ++p) {
+        vector<pair<long long, int>> rows;
+        for (int t = 0; t < nthreads; ++t) {
+            rows.insert(rows.end(), buckets[t][p].begin(), buckets[t][p].end());
+            vector<pair<long long, int>>().swap(buckets[t][p]);
+        }
+        sort(rows.begin(), rows.end(),
+             [](const pair<long long, int>& a, const pair<long long, int>& b) { return a.first < b.first; });
+
+        for (size_t i = 0; i < rows.size();) {
+            GroupEntry e;
+            e.key = rows[i].first;
+            for (; i < rows.size() && rows[i].first == e.key; ++i)
+                e.agg.add(rows[i].second);
+            results[p].push_back(e);
+        }
+    }
+
+    vector<GroupEntry> out;
+    for (auto& r : results)
+        out.insert(out.end(), r.begin(), r.end());
+    return out;
+}
+
+// Picks the sort path when a prefix sample shows too little repetition for
+// local pre-aggregation to pay off.
+vector<GroupEntry> parallelGroupBy(const vector<long long>& keys, const vector<int>& values,
+                                   GroupByStrategy strategy = GroupByStrategy::Auto) {
+    if (strategy == GroupByStrategy::Auto) {
+        size_t sample = min(keys.size(), SAMPLE_SIZE);
+        unordered_set<long long> distinct(keys.begin(), keys.begin() + sample);
+        strategy = distinct.size() * 2 > sample ? GroupByStrategy::Sort : GroupByStrategy::Hash;
+    }
+    return strategy == GroupByStrategy::Hash ? hashGroupBy(keys, values) : sortGroupBy(keys, values);
+}
+
+bool matchesSequential(const vector<long long>& keys, const vector<int>& values, const vector<GroupEntry>& groups) {
+    unordered_map<long long, Aggregate> expected;
+    for (size_t i = 0; i < keys.size(); ++i)
+        expected[keys[i]].add(values[i]);
+    if (expected.size() != groups.size()) return false;
+    for (const GroupEntry& e : groups) {
+        auto it = expected.find(e.key);
+        if (it == expected.end()) return false;
+        const Aggregate& a = it->second;
+        if (a.sum != e.agg.sum || a.count != e.agg.count || a.minVal != e.agg.minVal || a.maxVal != e.agg.maxVal)
+            return false;
+    }
+    return true;
+}
+
+int main() {
+    const int SIZE = 20000000;
+    const long long CARDINALITIES[] = {1000, 10000000};
+    const uint64_t SEED = 2024;
+    vector<long long> keys(SIZE);
+    vector<int> values(SIZE);
+
+    for (long long cardinality : CARDINALITIES) {
+        fillUniformInt(keys, 0LL, cardinality - 1, SEED);
+        fillUniformInt(values, 0, 9999, SEED + 1);
+
+        cout << "Group-By Results (" << cardinality << " keys):\n";
+
+        auto start = high_resolution_clock::now();
+        vector<GroupEntry> hashed = parallelGroupBy(keys, values, GroupByStrategy::Hash);
+        auto end = high_resolution_clock::now();
+        cout << "Hash Aggregation Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+
+        start = high_resolution_clock::now();
+        vector<GroupEntry> sorted = parallelGroupBy(keys, values, GroupByStrategy::Sort);
+        end = high_resolution_clock::now();
+        cout << "Sort Aggregation Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+
+        start = high_resolution_clock::now();
+        vector<GroupEntry> automatic = parallelGroupBy(keys, values);
+        end = high_resolution_clock::now();
+        cout << "Auto Aggregation Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+
+        bool ok = matchesSequential(keys, values, hashed) && matchesSequential(keys, values, sorted);
+        cout << "Groups: " << automatic.size() << "\n";
+        cout << "Correct: " << (ok ? "yes" : "no") << "\n";
+    }
+
+    return 0;
+}
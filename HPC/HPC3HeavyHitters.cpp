@@ -0,0 +1,327 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <climits>
+#include <algorithm>
+#include <unordered_map>
+#include <omp.h>
+#include "ParallelRandom.h"
+
+using namespace std;
+using namespace chrono;
+
+// Count-Min: estimates never undercount, and overcount by at most e/width * N
+// with probability 1 - e^-depth. Sketches with the same shape and seed merge by
+// adding counters.
+class CountMinSketch {
+public:
+    CountMinSketch(int width, int depth, uint64_t seed = 0)
+        : width(width), depth(depth), seed(seed), counts((size_t)width * depth, 0) {}
+
+    // Returns the updated estimate, so callers need not hash the item twice.
+    long long add(int item, long long count = 1) {
+        long long best = LLONG_MAX;
+        for (int r = 0; r < depth; ++r) {
+            long long& c = counts[(size_t)r * width + column(r, item)];
+            c += count;
+            best = min(best, c);
+        }
+        return best;
+    }
+
+    long long estimate(int item) const {
+        long long best = LLONG_MAX;
+        for (int r = 0; r < depth; ++r)
+            best = min(best, counts[(size_t)r * width + column(r, item)]);
+        return best;
+    }
+
+    void merge(const CountMinSketch& other) {
+        #pragma omp simd
+        for (size_t i = 0; i < counts.size(); ++i)
+            counts[i] += other.counts[i];
+    }
+
+    double epsilon() const { return exp(1.0) / width; }
+    double delta() const { return exp(-(double)depth); }
+
+private:
+    size_t column(int r, int item) const {
+        return toBounded(SplitMix64::bits(seed + r, (uint64_t)item), width);
+    }
+
+    int width;
+    int depth;
+    uint64_t seed;
+    vector<long long> counts;
+};
+
+// Open-addressing map from item to heap slot. SpaceSaving inserts and erases
+// on almost every tail item, which a node-based map turns into an allocation
+// per element. Erase uses backward shifting, so there are no tombstones.
+class SlotIndex {
+public:
+    explicit SlotIndex(int k) {
+        size_t capacity = 16;
+        while (capacity < 2 * (size_t)k) capacity *= 2;
+        keys.assign(capacity, 0);
+        slots.assign(capacity, 0);
+        used.assign(capacity, 0);
+        mask = capacity - 1;
+    }
+
+    int* find(int item) {
+        for (size_t i = home(item); used[i]; i = (i + 1) & mask)
+            if (keys[i] == item) return &slots[i];
+        return nullptr;
+    }
+
+    void set(int item, int slot) {
+        size_t i = home(item);
+        while (used[i] && keys[i] != item)
+            i = (i + 1) & mask;
+        keys[i] = item;
+        slots[i] = slot;
+        used[i] = 1;
+    }
+
+    void erase(int item) {
+        size_t i = home(item);
+        while (keys[i] != item)
+            i = (i + 1) & mask;
+        used[i] = 0;
+        for (size_t j = (i + 1) & mask; used[j]; j = (j + 1) & mask) {
+            size_t h = home(keys[j]);
+            if (((j - h) & mask) >= ((j - i) & mask)) {
+                keys[i] = keys[j];
+                slots[i] = slots[j];
+                used[i] = 1;
+                used[j] = 0;
+                i = j;
+            }
+        }
+    }
+
+    void clear() { fill(used.begin(), used.end(), 0); }
+
+private:
+    size_t home(int item) const { return SplitMix64::bits(0, (uint32_t)item) & mask; }
+
+    vector<int> keys;
+    vector<int> slots;
+    vector<char> used;
+    size_t mask;
+};
+
+// SpaceSaving with k counters kept in a min-heap: an unseen item replaces the
+// smallest counter and is charged its count as error. Counts never undercount,
+// and count - error never overcounts. With plain min + 1 admission the gap is
+// at most N / k. Merging follows
+// Agarwal et al., "Mergeable Summaries": an item missing from one side is
+// charged that side's minimum, then the k largest counters are kept.
+//
+// Items arrive through offer(), the filtered variant: an unseen item enters only
+// once an upper bound on its count (from Count-Min) beats the smallest counter,
+// and enters with that bound. The long tail then rarely touches the heap, and an untracked
+// item still never exceeds the minimum, so merging stays valid. Admitting at
+// the Count-Min bound rather than min + 1 can push the counters' sum past N, so
+// N / k no longer bounds the error; errorBound() reports the actual slack.
+class SpaceSaving {
+public:
+    struct Counter {
+        int item;
+        long long count;
+        long long error;
+    };
+
+    explicit SpaceSaving(int k) : k(k), slot(k) {}
+
+    void offer(int item, long long upper) {
+        if (int* i = slot.find(item)) {
+            ++heap[*i].count;
+            siftDown(*i);
+        } else if ((int)heap.size() < k) {
+            heap.push_back({item, upper, upper - 1});
+            siftUp(heap.size() - 1);
+        } else if (upper > heap[0].count) {
+            slot.erase(heap[0].item);
+            heap[0] = {item, upper, upper - 1};
+            siftDown(0);
+        }
+    }
+
+    void merge(const SpaceSaving& other) {
+        long long mine = minCount(), theirs = other.minCount();
+        unordered_map<int, Counter> combined;
+        for (const Counter& c : heap)
+            combined[c.item] = {c.item, c.count + theirs, c.error + theirs};
+        for (const Counter& c : other.heap) {
+            auto it = combined.find(c.item);
+            if (it == combined.end()) {
+                combined[c.item] = {c.item, c.count + mine, c.error + mine};
+            } else {
+                it->second.count += c.count - theirs;
+                it->second.error += c.error - theirs;
+            }
+        }
+
+        heap.clear();
+        for (const auto& c : combined)
+            heap.push_back(c.second);
+        if ((int)heap.size() > k) {
+            nth_element(heap.begin(), heap.begin() + k, heap.end(),
+                        [](const Counter& a, const Counter& b) { return a.count > b.count; });
+            heap.resize(k);
+        }
+        make_heap(heap.begin(), heap.end(), [](const Counter& a, const Counter& b) { return a.count > b.count; });
+        slot.clear();
+        for (size_t i = 0; i < heap.size(); ++i)
+            slot.set(heap[i].item, i);
+    }
+
+    // The most any count can exceed the truth: the largest charged error of a
+    // tracked item, or the minimum counter, which caps every untracked item.
+    long long errorBound() const {
+        long long bound = minCount();
+        for (const Counter& c : heap)
+            bound = max(bound, c.error);
+        return bound;
+    }
+    const vector<Counter>& counters() const { return heap; }
+
+private:
+    long long minCount() const {
+        return (int)heap.size() < k ? 0 : heap[0].count;
+    }
+
+    void place(size_t i, const Counter& c) {
+        heap[i] = c;
+        slot.set(c.item, i);
+    }
+
+    void siftUp(size_t i) {
+        Counter c = heap[i];
+        while (i > 0 && heap[(i - 1) / 2].count > c.count) {
+            place(i, heap[(i - 1) / 2]);
+            i = (i - 1) / 2;
+        }
+        place(i, c);
+    }
+
+    void siftDown(size_t i) {
+        Counter c = heap[i];
+        size_t n = heap.size();
+        for (;;) {
+            size_t child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && heap[child + 1].count < heap[child].count) ++child;
+            if (heap[child].count >= c.count) break;
+            place(i, heap[child]);
+            i = child;
+        }
+        place(i, c);
+    }
+
+    int k;
+    vector<Counter> heap;
+    SlotIndex slot;
+};
+
+struct HeavyHitter {
+    int item;
+    long long lower;
+    long long upper;
+};
+
+struct StreamSummary {
+    int minVal = INT_MAX;
+    int maxVal = INT_MIN;
+    long long sum = 0;
+    vector<HeavyHitter> top;
+    long long spaceSavingError = 0;
+    double countMinError = 0;
+};
+
+// One pass computes the HPC3 reduction and feeds both sketches. SpaceSaving
+// picks the candidates and gives the lower bound; the upper bound is the
+// tighter of the SpaceSaving count and the Count-Min estimate.
+StreamSummary parallelHeavyHitters(const vector<int>& data, int k, int counters = 1024,
+                                   int width = 1 << 14, int depth = 4) {
+    long long n = data.size();
+    StreamSummary summary;
+    CountMinSketch cm(width, depth);
+    SpaceSaving ss(counters);
+    int minVal = INT_MAX, maxVal = INT_MIN;
+    long long sum = 0;
+
+    #pragma omp parallel reduction(min:minVal) reduction(max:maxVal) reduction(+:sum)
+    {
+        CountMinSketch localCm(width, depth);
+        SpaceSaving localSs(counters);
+
+        #pragma omp for schedule(static) nowait
+        for (long long i = 0; i < n; ++i) {
+            int v = data[i];
+            minVal = min(minVal, v);
+            maxVal = max(maxVal, v);
+            sum += v;
+            localSs.offer(v, localCm.add(v));
+        }
+
+        #pragma omp critical
+        {
+            cm.merge(localCm);
+            ss.merge(localSs);
+        }
+    }
+
+    for (const SpaceSaving::Counter& c : ss.counters())
+        summary.top.push_back({c.item, c.count - c.error, min(c.count, cm.estimate(c.item))});
+    sort(summary.top.begin(), summary.top.end(), [](const HeavyHitter& a, const HeavyHitter& b) {
+        return a.upper != b.upper ? a.upper > b.upper : a.item < b.item;
+    });
+    if ((int)summary.top.size() > k) summary.top.resize(k);
+
+    summary.minVal = minVal;
+    summary.maxVal = maxVal;
+    summary.sum = sum;
+    summary.spaceSavingError = ss.errorBound();
+    summary.countMinError = cm.epsilon() * n;
+    return summary;
+}
+
+int main() {
+    const int SIZE = 50000000;
+    const int DOMAIN = 1000000;
+    const int K = 10;
+    const uint64_t SEED = 2024;
+    vector<int> data(SIZE);
+
+    fillZipf(data, DOMAIN, 1.05, SEED);
+
+    auto start = high_resolution_clock::now();
+    StreamSummary summary = parallelHeavyHitters(data, K);
+    auto end = high_resolution_clock::now();
+
+    vector<long long> exact(DOMAIN + 1, 0);
+    for (int v : data)
+        ++exact[v];
+
+    cout << "Heavy Hitter Results:\n";
+    cout << "Min: " << summary.minVal << "\n";
+    cout << "Max: " << summary.maxVal << "\n";
+    cout << "Sum: " << summary.sum << "\n";
+    cout << "Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+    cout << "SpaceSaving Error Bound: " << summary.spaceSavingError << "\n";
+    cout << "Count-Min Error Bound: " << (long long)summary.countMinError << "\n";
+    bool ok = true;
+    for (const HeavyHitter& h : summary.top) {
+        cout << "  " << h.item << ": [" << h.lower << ", " << h.upper << "] exact " << exact[h.item] << "\n";
+        ok = ok && h.lower <= exact[h.item] && exact[h.item] <= h.upper;
+        ok = ok && h.upper - exact[h.item] <= summary.spaceSavingError;
+    }
+    cout << "Bounds hold: " << (ok ? "yes" : "no") << "\n";
+
+    return 0;
+}
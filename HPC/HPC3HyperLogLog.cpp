@@ -0,0 +1,80 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <omp.h>
+#include "ParallelRandom.h"
+#include "HyperLogLog.h"
+
+using namespace std;
+using namespace chrono;
+
+template <typename T>
+HyperLogLog parallelDistinctCount(const vector<T>& data, int precision = 14) {
+    HyperLogLog total(precision);
+    long long n = data.size();
+
+    #pragma omp parallel
+    {
+        HyperLogLog local(precision);
+        int t = omp_get_thread_num();
+        int nt = omp_get_num_threads();
+        long long begin = n * t / nt;
+        long long end = n * (t + 1) / nt;
+        local.addAll(data.data() + begin, end - begin);
+
+        #pragma omp critical
+        total.merge(local);
+    }
+    return total;
+}
+
+int main() {
+    const int SIZE = 100000000;
+    const long long DOMAINS[] = {1000, 1000000, 100000000};
+    const int PRECISIONS[] = {10, 14, 18};
+    const uint64_t SEED = 2024;
+    vector<long long> data(SIZE);
+
+    cout << "HyperLogLog Distinct Count Results:\n";
+    for (long long domain : DOMAINS) {
+        fillUniformInt(data, 0LL, domain - 1, SEED);
+
+        vector<char> seen(domain, 0);
+        #pragma omp parallel for
+        for (long long i = 0; i < SIZE; ++i)
+            seen[data[i]] = 1;
+        long long exact = 0;
+        #pragma omp parallel for reduction(+:exact)
+        for (long long v = 0; v < domain; ++v)
+            exact += seen[v];
+
+        cout << "Exact Distinct: " << exact << "\n";
+        for (int p : PRECISIONS) {
+            auto start = high_resolution_clock::now();
+            HyperLogLog sketch = parallelDistinctCount(data, p);
+            auto end = high_resolution_clock::now();
+
+            HyperLogLog restored = HyperLogLog::deserialize(sketch.serialize());
+            double estimate = restored.estimate();
+            cout << "  p=" << p << " (" << sketch.bytes() << " bytes): " << (long long)estimate
+                 << ", error " << 100.0 * fabs(estimate - exact) / exact << "%, "
+                 << duration_cast<milliseconds>(end - start).count() << " ms\n";
+        }
+    }
+
+    bool rejected = true;
+    for (uint8_t p : {0, 3, 19, 64, 255}) {
+        try {
+            HyperLogLog::deserialize({'H', 'L', 1, p});
+            rejected = false;
+        } catch (const invalid_argument&) {
+        }
+    }
+    cout << "Bad Precision Rejected: " << (rejected ? "yes" : "no") << "\n";
+
+    return 0;
+}
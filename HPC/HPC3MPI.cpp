@@ -0,0 +1,253 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <mpi.h>
+#include <omp.h>
+#include "ParallelRandom.h"
+#include "HyperLogLog.h"
+
+using namespace std;
+
+// Build:  mpicxx -O3 -march=native -fopenmp HPC3MPI.cpp -o HPC3MPI
+// Run:    mpirun -np 4 ./HPC3MPI [file] [elements]
+
+const int SKETCH_BITS = 12;
+const int SKETCH_REGISTERS = 1 << SKETCH_BITS;
+
+// Everything the HPC3 reduction reports, plus central moments for the variance
+// and a HyperLogLog sketch (HyperLogLog.h, the same hash and estimator as
+// HPC3HyperLogLog.cpp) for an approximate distinct count. All of it merges
+// associatively, so the same combine runs between threads and between ranks.
+struct Aggregate {
+    long long count;
+    int minVal;
+    int maxVal;
+    long long sum;
+    double mean;
+    double m2;
+    uint8_t registers[SKETCH_REGISTERS];
+
+    Aggregate() : count(0), minVal(INT_MAX), maxVal(INT_MIN), sum(0), mean(0.0), m2(0.0) {
+        fill(registers, registers + SKETCH_REGISTERS, 0);
+    }
+
+    void add(int x) {
+        ++count;
+        minVal = min(minVal, x);
+        maxVal = max(maxVal, x);
+        sum += x;
+        double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+
+        HyperLogLog::update(registers, SKETCH_BITS, HyperLogLog::hash((uint64_t)x));
+    }
+
+    // Chan et al.'s pairwise update for the mean and second moment.
+    void merge(const Aggregate& o) {
+        if (o.count == 0) return;
+        long long n = count + o.count;
+        double delta = o.mean - mean;
+        m2 += o.m2 + delta * delta * ((double)count * o.count / n);
+        mean += delta * o.count / n;
+        count = n;
+        minVal = min(minVal, o.minVal);
+        maxVal = max(maxVal, o.maxVal);
+        sum += o.sum;
+        HyperLogLog::mergeRegisters(registers, o.registers, SKETCH_REGISTERS);
+    }
+
+    double variance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+
+    double distinct() const { return HyperLogLog::estimate(registers, SKETCH_BITS); }
+};
+
+void mergeAggregates(void* in, void* inout, int* len, MPI_Datatype*) {
+    const Aggregate* a = static_cast<const Aggregate*>(in);
+    Aggregate* b = static_cast<Aggregate*>(inout);
+    for (int i = 0; i < *len; ++i)
+        b[i].merge(a[i]);
+}
+
+// Describes every field, so MPI can move Aggregate between heterogeneous ranks.
+MPI_Datatype aggregateType() {
+    int lengths[] = {1, 1, 1, 1, 1, 1, SKETCH_REGISTERS};
+    MPI_Aint offsets[] = {offsetof(Aggregate, count), offsetof(Aggregate, minVal), offsetof(Aggregate, maxVal),
+                          offsetof(Aggregate, sum), offsetof(Aggregate, mean), offsetof(Aggregate, m2),
+                          offsetof(Aggregate, registers)};
+    MPI_Datatype types[] = {MPI_LONG_LONG, MPI_INT, MPI_INT, MPI_LONG_LONG, MPI_DOUBLE, MPI_DOUBLE, MPI_UINT8_T};
+    MPI_Datatype packed, resized;
+    MPI_Type_create_struct(7, lengths, offsets, types, &packed);
+    MPI_Type_create_resized(packed, 0, sizeof(Aggregate), &resized);
+    MPI_Type_commit(&resized);
+    MPI_Type_free(&packed);
+    return resized;
+}
+
+// Thread-level reduction over one rank's shard.
+Aggregate threadReduce(const int* data, long long n) {
+    Aggregate total;
+
+    #pragma omp parallel
+    {
+        Aggregate local;
+
+        #pragma omp for schedule(static) nowait
+        for (long long i = 0; i < n; ++i)
+            local.add(data[i]);
+
+        #pragma omp critical
+        total.merge(local);
+    }
+    return total;
+}
+
+// Maps elements [begin, end) of a file of ints read-only. The mapping has to
+// start on a page boundary, so it may begin a little before the shard.
+struct MappedShard {
+    const int* data = nullptr;
+    long long size = 0;
+    void* base = MAP_FAILED;
+    size_t length = 0;
+
+    MappedShard(const string& path, long long begin, long long end) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        size_t page = sysconf(_SC_PAGESIZE);
+        size_t from = begin * sizeof(int) / page * page;
+        length = end * sizeof(int) - from;
+        if (length > 0) base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, from);
+        close(fd);
+        if (base == MAP_FAILED) return;
+        madvise(base, length, MADV_SEQUENTIAL);
+        data = reinterpret_cast<const int*>(static_cast<const char*>(base) + (begin * sizeof(int) - from));
+        size = end - begin;
+    }
+
+    ~MappedShard() {
+        if (base != MAP_FAILED) munmap(base, length);
+    }
+
+    bool ok() const { return data != nullptr || size == 0; }
+};
+
+// Every rank writes its own shard of the input, so the file is produced in parallel.
+bool writeShard(const string& path, long long begin, long long end, uint64_t seed) {
+    vector<int> shard(end - begin);
+    fillUniformInt(shard, 0, 9999, seed, begin);
+    int fd = open(path.c_str(), O_WRONLY);
+    if (fd < 0) return false;
+    const char* bytes = reinterpret_cast<const char*>(shard.data());
+    size_t remaining = shard.size() * sizeof(int);
+    off_t offset = begin * sizeof(int);
+    while (remaining > 0) {
+        ssize_t written = pwrite(fd, bytes, remaining, offset);
+        if (written <= 0) break;
+        bytes += written;
+        offset += written;
+        remaining -= written;
+    }
+    close(fd);
+    return remaining == 0;
+}
+
+int main(int argc, char** argv) {
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+    int rank, ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+
+    string path = argc > 1 ? argv[1] : "/tmp/hpc3_mpi_data.bin";
+    long long size = argc > 2 ? atoll(argv[2]) : 100000000;
+    const uint64_t SEED = 2024;
+
+    long long begin = size * rank / ranks;
+    long long end = size * (rank + 1) / ranks;
+
+    if (rank == 0) {
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        bool created = fd >= 0 && ftruncate(fd, size * sizeof(int)) == 0;
+        if (fd >= 0) close(fd);
+        if (!created) {
+            cerr << "Cannot create " << path << "\n";
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (!writeShard(path, begin, end, SEED)) {
+        cerr << "Rank " << rank << ": cannot write its shard of " << path << "\n";
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    MappedShard shard(path, begin, end);
+    if (!shard.ok()) {
+        cerr << "Rank " << rank << ": cannot map " << path << "\n";
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    MPI_Datatype type = aggregateType();
+    MPI_Op op;
+    MPI_Op_create(mergeAggregates, 1, &op);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start = MPI_Wtime();
+    Aggregate local = threadReduce(shard.data, shard.size);
+    double localTime = MPI_Wtime() - start;
+
+    Aggregate global;
+    MPI_Reduce(&local, &global, 1, type, op, 0, MPI_COMM_WORLD);
+    double reduceTime = MPI_Wtime() - start;
+
+    // Allreduce hands every rank the global result, so each can follow up on
+    // its own shard: here, counting elements above the global mean.
+    Aggregate everywhere;
+    MPI_Allreduce(&local, &everywhere, 1, type, op, MPI_COMM_WORLD);
+    long long above = 0, totalAbove = 0;
+    #pragma omp parallel for reduction(+:above)
+    for (long long i = 0; i < shard.size; ++i)
+        above += shard.data[i] > everywhere.mean;
+    MPI_Reduce(&above, &totalAbove, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    double slowest;
+    MPI_Reduce(&localTime, &slowest, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        MappedShard whole(path, 0, size);
+        int minVal = INT_MAX, maxVal = INT_MIN;
+        long long sum = 0;
+        for (long long i = 0; i < whole.size; ++i) {
+            minVal = min(minVal, whole.data[i]);
+            maxVal = max(maxVal, whole.data[i]);
+            sum += whole.data[i];
+        }
+        bool ok = global.count == size && global.minVal == minVal && global.maxVal == maxVal &&
+                  global.sum == sum && everywhere.sum == sum;
+
+        cout << "Ranks: " << ranks << ", Threads per Rank: " << omp_get_max_threads() << "\n";
+        cout << "Slowest Rank Reduction Time: " << slowest * 1000 << " ms\n";
+        cout << "Reduction + MPI_Reduce Time: " << reduceTime * 1000 << " ms\n";
+        cout << "Min: " << global.minVal << "\n";
+        cout << "Max: " << global.maxVal << "\n";
+        cout << "Sum: " << global.sum << "\n";
+        cout << "Average: " << global.mean << "\n";
+        cout << "Variance: " << global.variance() << "\n";
+        cout << "Approximate Distinct: " << global.distinct() << "\n";
+        cout << "Above Average: " << totalAbove << "\n";
+        cout << "Correct: " << (ok ? "yes" : "no") << "\n";
+    }
+
+    MPI_Op_free(&op);
+    MPI_Type_free(&type);
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <omp.h>
+#include "ParallelRandom.h"
+#include "HashPartition.h"
+
+using namespace std;
+using namespace chrono;
+
+struct FrequencyResult {
+    int mode = 0;
+    long long modeCount = 0;
+    long long distinct = 0;
+    vector<pair<int, long long>> table;   // (value, count), ascending by value
+};
+
+// Linear-probing value -> count table that doubles when half full. A zero
+// count marks an empty slot, so a probe touches one cache line. Slots come from
+// Fibonacci hashing, which spreads a dense run of values over distinct slots
+// without collisions, so a small domain probes once per element and the probe
+// loop predicts well.
+class CountTable {
+public:
+    CountTable() { reset(64); }
+
+    // Sizes the table for n keys up front. Required before inserting keys in
+    // the slot order of another table: while such a table is still small, all
+    // of them land in a single growing cluster.
+    void reserve(size_t n) {
+        size_t capacity = 64;
+        while (capacity < 2 * n)
+            capacity *= 2;
+        if (capacity > slots.size() && count == 0) reset(capacity);
+    }
+
+    size_t size() const { return count; }
+
+    void add(int key, long long by = 1) {
+        if (2 * (count + 1) > slots.size()) grow();
+        size_t i = ((uint32_t)key * 0x9e3779b97f4a7c15ULL) >> shift;
+        while (slots[i].count && slots[i].key != key)
+            i = (i + 1) & mask;
+        if (!slots[i].count) {
+            slots[i].key = key;
+            ++count;
+        }
+        slots[i].count += by;
+    }
+
+    template <typename F>
+    void forEach(F f) const {
+        for (const Slot& s : slots)
+            if (s.count) f(s.key, s.count);
+    }
+
+private:
+    struct Slot {
+        long long count;
+        int key;
+    };
+
+    void reset(size_t capacity) {
+        slots.assign(capacity, Slot{0, 0});
+        mask = capacity - 1;
+        shift = 64 - __builtin_ctzll(capacity);
+        count = 0;
+    }
+
+    void grow() {
+        vector<Slot> old;
+        old.swap(slots);
+        reset(old.size() * 2);
+        for (const Slot& s : old)
+            if (s.count) add(s.key, s.count);
+    }
+
+    vector<Slot> slots;
+    size_t mask;
+    int shift;
+    size_t count;
+};
+
+// Largest dense range, in values, given a private count array per thread.
+const long long DENSE_LIMIT = 1 << 22;
+
+// One sweep over the data. Values inside [lo, hi] are counted in a dense
+// private array per thread when that range is small enough; everything else
+// (values outside the range, or all of them for a large or unknown domain)
+// goes to a private hash table. The dense arrays are summed by value range in
+// parallel; the hash tables are split into radix partitions, which are then
+// merged independently of each other. Ties for the mode go to the smallest value.
+FrequencyResult frequencies(const vector<int>& data, int lo = 0, int hi = -1) {
+    long long n = data.size();
+    long long range = (long long)hi - lo + 1;
+    bool dense = range > 0 && range <= DENSE_LIMIT;
+    if (!dense) range = 0;
+    int nthreads = omp_get_max_threads();
+    // Allocated up front: the runtime may start fewer threads than asked for,
+    // and the combine loop reads every thread's counts.
+    vector<vector<long long>> denseCounts(nthreads, vector<long long>(range, 0));
+    vector<vector<vector<pair<int, long long>>>> spills(nthreads, vector<vector<pair<int, long long>>>(PARTITIONS));
+    vector<long long> merged(range);
+    vector<CountTable> partitions(PARTITIONS);
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        int t = omp_get_thread_num();
+        vector<long long>& counts = denseCounts[t];
+        CountTable mine;
+
+        #pragma omp for schedule(static)
+        for (long long i = 0; i < n; ++i) {
+            long long offset = (long long)data[i] - lo;
+            if (offset >= 0 && offset < range) {
+                ++counts[offset];
+            } else {
+                mine.add(data[i]);
+            }
+        }
+
+        mine.forEach([&](int key, long long c) { spills[t][partitionOf(hashKey(key))].push_back({key, c}); });
+
+        #pragma omp for schedule(static)
+        for (long long v = 0; v < range; ++v) {
+            long long total = 0;
+            for (int u = 0; u < nthreads; ++u)
+                total += denseCounts[u][v];
+            merged[v] = total;
+        }
+
+        #pragma omp for schedule(dynamic, 1)
+        for (int p = 0; p < PARTITIONS; ++p) {
+            size_t entries = 0;
+            for (int u = 0; u < nthreads; ++u)
+                entries += spills[u][p].size();
+            partitions[p].reserve(entries);
+            for (int u = 0; u < nthreads; ++u)
+                for (const pair<int, long long>& entry : spills[u][p])
+                    partitions[p].add(entry.first, entry.second);
+        }
+    }
+
+    FrequencyResult result;
+    for (long long v = 0; v < range; ++v)
+        if (merged[v]) result.table.push_back({(int)(lo + v), merged[v]});
+    for (const CountTable& table : partitions)
+        table.forEach([&](int key, long long c) { result.table.push_back({key, c}); });
+    sort(result.table.begin(), result.table.end());
+
+    result.distinct = result.table.size();
+    for (const pair<int, long long>& entry : result.table) {
+        if (entry.second > result.modeCount) {
+            result.mode = entry.first;
+            result.modeCount = entry.second;
+        }
+    }
+    return result;
+}
+
+FrequencyResult sequentialFrequencies(const vector<int>& data) {
+    unordered_map<int, long long> counts;
+    for (int x : data)
+        ++counts[x];
+
+    FrequencyResult result;
+    result.table.assign(counts.begin(), counts.end());
+    sort(result.table.begin(), result.table.end());
+    result.distinct = result.table.size();
+    for (const pair<int, long long>& entry : result.table) {
+        if (entry.second > result.modeCount) {
+            result.mode = entry.first;
+            result.modeCount = entry.second;
+        }
+    }
+    return result;
+}
+
+template <typename F>
+FrequencyResult timed(const char* label, F f) {
+    auto start = high_resolution_clock::now();
+    FrequencyResult r = f();
+    auto end = high_resolution_clock::now();
+    cout << "  " << label << " Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+    return r;
+}
+
+int main() {
+    const int SIZE = 100000000;
+    const uint64_t SEED = 2024;
+    vector<int> data(SIZE), skewed(SIZE), wide(SIZE / 10);
+
+    fillUniformInt(data, 0, 9999, SEED);
+    fillZipf(skewed, 1000000, 1.1, SEED);
+    fillUniformInt(wide, 0, INT_MAX, SEED);
+
+    struct Case {
+        const char* name;
+        const vector<int>* data;
+        int lo, hi;
+    };
+    Case cases[] = {
+        {"Uniform 0..9999, dense", &data, 0, 9999},
+        {"Uniform 0..9999, hashed", &data, 0, -1},
+        {"Zipf 1..1000000, dense", &skewed, 1, 1000000},
+        {"Zipf 1..1000000, dense 1..1000 with hashed tail", &skewed, 1, 1000},
+        {"Wide 0..INT_MAX, hashed", &wide, 0, -1},
+    };
+
+    for (const Case& c : cases) {
+        cout << c.name << ":\n";
+        FrequencyResult expected = timed("unordered_map", [&] { return sequentialFrequencies(*c.data); });
+        FrequencyResult result = timed("Parallel", [&] { return frequencies(*c.data, c.lo, c.hi); });
+        cout << "  Mode: " << result.mode << " (" << result.modeCount << " times)\n";
+        cout << "  Distinct: " << result.distinct << "\n";
+        cout << "  Correct: " << (result.table == expected.table && result.mode == expected.mode ? "yes" : "no") << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,206 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <climits>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <omp.h>
+#include "ParallelRandom.h"
+
+using namespace std;
+using namespace chrono;
+
+struct NarrowResult {
+    long long minVal;
+    long long maxVal;
+    long long sum;
+};
+
+// Widening sum: the block accumulator Acc is only as wide as it needs to be
+// for BLOCK values of T, which keeps more lanes per SIMD register. It is
+// flushed into a 64-bit total before it can overflow. Min and max are tracked
+// at the accumulator's width too: GCC 12 turns simd min/max reductions on 8-
+// and 16-bit lanes into a scalar loop, while at the wider width all three
+// reductions share one vector loop.
+template <typename T, typename Acc>
+NarrowResult narrowReduce(const T* data, long long n) {
+    const long long BLOCK = ((unsigned long long)numeric_limits<Acc>::max()) / numeric_limits<T>::max();
+    long long blocks = (n + BLOCK - 1) / BLOCK;
+    Acc minVal = numeric_limits<T>::max();
+    Acc maxVal = numeric_limits<T>::min();
+    long long sum = 0;
+
+    #pragma omp parallel for schedule(static) reduction(min:minVal) reduction(max:maxVal) reduction(+:sum)
+    for (long long b = 0; b < blocks; ++b) {
+        const T* block = data + b * BLOCK;
+        int len = min(BLOCK, n - b * BLOCK);
+        Acc acc = 0;
+        Acc lo = numeric_limits<T>::max();
+        Acc hi = numeric_limits<T>::min();
+
+        #pragma omp simd reduction(+:acc) reduction(min:lo) reduction(max:hi)
+        for (int i = 0; i < len; ++i) {
+            Acc x = block[i];
+            acc += x;
+            lo = min(lo, x);
+            hi = max(hi, x);
+        }
+        sum += acc;
+        minVal = min(minVal, lo);
+        maxVal = max(maxVal, hi);
+    }
+    return {minVal, maxVal, sum};
+}
+
+// Fixed-width bit packing: value i occupies bits [i*bits, (i+1)*bits) of a
+// stream of 64-bit words. Groups of 64 values start on a word boundary, so
+// each group unpacks independently. Widths are 1..16 bits, and every value
+// must fit in the width; otherwise the constructor throws.
+class PackedArray {
+public:
+    PackedArray(const vector<uint16_t>& values, int bits) : bits(bits), n(values.size()) {
+        if (bits < 1 || bits > 16) throw invalid_argument("packed width must be in [1, 16] bits");
+        const uint64_t mask = (1u << bits) - 1;
+        bool tooWide = false;
+        words.assign((n * bits + 63) / 64 + 1, 0);
+        long long groups = (n + 63) / 64;
+        #pragma omp parallel for schedule(static) reduction(||:tooWide)
+        for (long long g = 0; g < groups; ++g) {
+            long long end = min(n, (g + 1) * 64);
+            for (long long i = g * 64; i < end; ++i) {
+                uint64_t v = values[i] & mask;
+                tooWide = tooWide || values[i] > mask;
+                unsigned long long bit = (unsigned long long)i * bits;
+                words[bit >> 6] |= v << (bit & 63);
+                if ((bit & 63) + bits > 64)
+                    words[(bit >> 6) + 1] |= v >> (64 - (bit & 63));
+            }
+        }
+        if (tooWide) throw invalid_argument("value does not fit in the packed width");
+    }
+
+    long long size() const { return n; }
+    size_t bytes() const { return words.size() * sizeof(uint64_t); }
+
+    // Reads the 32-bit window starting at the value's first byte, which holds
+    // all of it for widths up to 25 bits. Little-endian only.
+    uint16_t get(long long i) const {
+        unsigned long long bit = (unsigned long long)i * bits;
+        uint32_t window;
+        memcpy(&window, (const char*)words.data() + (bit >> 3), sizeof(window));
+        return (window >> (bit & 7)) & ((1u << bits) - 1);
+    }
+
+    // Unpacks into a small uint16 buffer and reduces that with the widening
+    // kernel. Unpacking costs more instructions than the uint16 path, so this
+    // pays off only once enough cores share the memory bus to saturate it.
+    NarrowResult reduce() const {
+        const long long GROUP = 4096;
+        long long groups = (n + GROUP - 1) / GROUP;
+        long long minVal = LLONG_MAX, maxVal = LLONG_MIN, sum = 0;
+
+        #pragma omp parallel reduction(min:minVal) reduction(max:maxVal) reduction(+:sum)
+        {
+            uint16_t buffer[GROUP];
+
+            #pragma omp for schedule(static)
+            for (long long g = 0; g < groups; ++g) {
+                long long begin = g * GROUP;
+                long long len = min(GROUP, n - begin);
+                #pragma omp simd
+                for (long long i = 0; i < len; ++i)
+                    buffer[i] = get(begin + i);
+
+                unsigned int acc = 0, lo = UINT16_MAX, hi = 0;
+                #pragma omp simd reduction(+:acc) reduction(min:lo) reduction(max:hi)
+                for (long long i = 0; i < len; ++i) {
+                    unsigned int x = buffer[i];
+                    acc += x;
+                    lo = min(lo, x);
+                    hi = max(hi, x);
+                }
+                sum += acc;
+                minVal = min<long long>(minVal, lo);
+                maxVal = max<long long>(maxVal, hi);
+            }
+        }
+        return {minVal, maxVal, sum};
+    }
+
+private:
+    int bits;
+    long long n;
+    vector<uint64_t> words;
+};
+
+NarrowResult intReduce(const vector<int>& data) {
+    int minVal = data[0], maxVal = data[0];
+    long long sum = 0;
+    #pragma omp parallel for reduction(min:minVal) reduction(max:maxVal) reduction(+:sum)
+    for (long long i = 0; i < (long long)data.size(); ++i) {
+        if (data[i] < minVal) minVal = data[i];
+        if (data[i] > maxVal) maxVal = data[i];
+        sum += data[i];
+    }
+    return {minVal, maxVal, sum};
+}
+
+template <typename F>
+NarrowResult timed(const char* label, size_t bytes, F f) {
+    const int REPEATS = 5;
+    NarrowResult r = f();
+    auto start = high_resolution_clock::now();
+    for (int k = 0; k < REPEATS; ++k)
+        r = f();
+    auto end = high_resolution_clock::now();
+    double seconds = duration<double>(end - start).count() / REPEATS;
+    cout << label << ": " << seconds * 1000 << " ms, " << bytes / 1048576 << " MiB ("
+         << bytes / seconds / 1e9 << " GB/s) -> Min " << r.minVal << ", Max " << r.maxVal
+         << ", Sum " << r.sum << "\n";
+    return r;
+}
+
+int main() {
+    const int SIZE = 100000000;
+    const int BITS = 14;
+    const uint64_t SEED = 2024;
+
+    vector<int> wide(SIZE);
+    fillUniformInt(wide, 0, 9999, SEED);
+
+    vector<uint16_t> narrow(SIZE);
+    #pragma omp parallel for simd
+    for (int i = 0; i < SIZE; ++i)
+        narrow[i] = wide[i];
+
+    vector<uint8_t> bytes(SIZE);
+    fillUniformInt(bytes, (uint8_t)0, (uint8_t)255, SEED);
+
+    PackedArray packed(narrow, BITS);
+
+    cout << "Narrow-Width Reduction Results:\n";
+    NarrowResult a = timed("int32", wide.size() * sizeof(int), [&] { return intReduce(wide); });
+    NarrowResult b = timed("uint16", narrow.size() * sizeof(uint16_t), [&] {
+        return narrowReduce<uint16_t, uint32_t>(narrow.data(), narrow.size());
+    });
+    NarrowResult c = timed("14-bit packed", packed.bytes(), [&] { return packed.reduce(); });
+    timed("uint8 (0..255 data)", bytes.size(), [&] {
+        return narrowReduce<uint8_t, uint16_t>(bytes.data(), bytes.size());
+    });
+
+    bool ok = a.minVal == b.minVal && a.maxVal == b.maxVal && a.sum == b.sum &&
+              a.minVal == c.minVal && a.maxVal == c.maxVal && a.sum == c.sum;
+
+    // 9999 needs 14 bits, so 13 is rejected rather than bleeding into the neighbor.
+    try {
+        PackedArray tooNarrow(narrow, BITS - 1);
+        ok = false;
+    } catch (const invalid_argument&) {
+    }
+    cout << "Correct: " << (ok ? "yes" : "no") << "\n";
+
+    return 0;
+}
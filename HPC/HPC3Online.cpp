@@ -0,0 +1,151 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include <omp.h>
+#include "ParallelRandom.h"
+
+using namespace std;
+using namespace chrono;
+
+struct OnlineOptions {
+    double relativeError = 0.001;   // stop once the interval half-width is within this fraction
+    double z = 1.96;                // normal quantile of the confidence level, 1.96 for 95%
+    long long blockSize = 4096;
+    long long blocksPerRound = 256;
+    long long minBlocks = 30;       // below this the normal approximation is not trusted
+};
+
+struct OnlineEstimate {
+    long long blocksSeen = 0;
+    long long elementsSeen = 0;
+    double fraction = 0.0;
+    double average = 0.0;
+    double averageHalfWidth = 0.0;
+    double sum = 0.0;
+    double sumHalfWidth = 0.0;
+    bool exact = false;
+};
+
+// Online aggregation (Hellerstein et al.): blocks are read in a random order,
+// so after m of N blocks the ones seen are a simple random sample of blocks.
+// The average is the ratio estimator sum(t) / sum(len) over sampled block totals
+// t and lengths len; its variance carries the finite population correction
+// (1 - m / N), so the interval shrinks to zero as the scan completes. Each round
+// reduces a batch of blocks in parallel, then refines the estimate and calls
+// report with it. Stops as soon as the relative error bound is met.
+template <typename Report>
+OnlineEstimate onlineAverage(const vector<int>& data, const OnlineOptions& opt, uint64_t seed, Report report) {
+    long long n = data.size();
+    long long blocks = (n + opt.blockSize - 1) / opt.blockSize;
+
+    vector<long long> order(blocks);
+    iota(order.begin(), order.end(), 0);
+    for (long long i = blocks - 1; i > 0; --i)
+        swap(order[i], order[toBounded(SplitMix64::bits(seed, i), i + 1)]);
+
+    vector<long long> totals(opt.blocksPerRound);
+    double sumT = 0, sumL = 0, sumTT = 0, sumTL = 0, sumLL = 0;
+    OnlineEstimate est;
+
+    for (long long first = 0; first < blocks; first += opt.blocksPerRound) {
+        long long last = min(blocks, first + opt.blocksPerRound);
+
+        #pragma omp parallel for schedule(static)
+        for (long long k = first; k < last; ++k) {
+            long long begin = order[k] * opt.blockSize;
+            long long len = min(opt.blockSize, n - begin);
+            long long t = 0;
+            #pragma omp simd reduction(+:t)
+            for (long long i = 0; i < len; ++i)
+                t += data[begin + i];
+            totals[k - first] = t;
+        }
+
+        for (long long k = first; k < last; ++k) {
+            double t = totals[k - first];
+            double len = min(opt.blockSize, n - order[k] * opt.blockSize);
+            sumT += t;
+            sumL += len;
+            sumTT += t * t;
+            sumTL += t * len;
+            sumLL += len * len;
+        }
+
+        long long m = last;
+        double ratio = sumT / sumL;
+        double residuals = max(0.0, sumTT - 2 * ratio * sumTL + ratio * ratio * sumLL);
+        double meanLen = sumL / m;
+        double variance = m > 1 ? (1.0 - (double)m / blocks) * residuals / (m - 1) / (m * meanLen * meanLen) : 0.0;
+
+        est.blocksSeen = m;
+        est.elementsSeen = sumL;
+        est.fraction = (double)m / blocks;
+        est.average = ratio;
+        est.averageHalfWidth = opt.z * sqrt(variance);
+        est.sum = ratio * n;
+        est.sumHalfWidth = est.averageHalfWidth * n;
+        est.exact = m == blocks;
+        report(est);
+
+        if (est.exact || (m >= opt.minBlocks && est.averageHalfWidth <= opt.relativeError * fabs(est.average)))
+            break;
+    }
+    return est;
+}
+
+int main() {
+    const int SIZE = 100000000;
+    const uint64_t SEED = 2024;
+    vector<int> shuffled(SIZE), clustered(SIZE);
+
+    fillUniformInt(shuffled, 0, 9999, SEED);
+    fillUniformInt(clustered, 0, 99, SEED + 1);
+    #pragma omp parallel for simd
+    for (int i = 0; i < SIZE; ++i)
+        clustered[i] += (int)((long long)i * 9900 / SIZE);
+
+    const vector<int>* inputs[] = {&shuffled, &clustered};
+    const char* names[] = {"Shuffled", "Clustered"};
+    const double BOUNDS[] = {0.01, 0.001};
+
+    for (int d = 0; d < 2; ++d) {
+        const vector<int>& data = *inputs[d];
+
+        auto start = high_resolution_clock::now();
+        long long exactSum = 0;
+        #pragma omp parallel for reduction(+:exactSum)
+        for (int i = 0; i < SIZE; ++i)
+            exactSum += data[i];
+        auto end = high_resolution_clock::now();
+        double exactAverage = (double)exactSum / SIZE;
+        cout << names[d] << " data: exact Sum " << exactSum << ", Average " << exactAverage << " in "
+             << duration<double, milli>(end - start).count() << " ms\n";
+
+        for (double bound : BOUNDS) {
+            OnlineOptions opt;
+            opt.relativeError = bound;
+            int rounds = 0;
+
+            start = high_resolution_clock::now();
+            OnlineEstimate est = onlineAverage(data, opt, SEED, [&](const OnlineEstimate& e) {
+                if (++rounds % 8 == 1)
+                    cout << "    " << e.fraction * 100 << "% read: Average " << e.average << " +/- "
+                         << e.averageHalfWidth << "\n";
+            });
+            end = high_resolution_clock::now();
+
+            bool covered = fabs(est.average - exactAverage) <= est.averageHalfWidth;
+            cout << "  Bound " << bound * 100 << "%: stopped after " << est.fraction * 100 << "% in "
+                 << duration<double, milli>(end - start).count() << " ms\n";
+            cout << "    Sum " << (long long)est.sum << " +/- " << (long long)est.sumHalfWidth
+                 << ", Average " << est.average << " +/- " << est.averageHalfWidth
+                 << " | Exact value inside interval: " << (covered ? "yes" : "no") << "\n";
+        }
+    }
+
+    return 0;
+}
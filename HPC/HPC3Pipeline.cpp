@@ -0,0 +1,241 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <omp.h>
+#include "ParallelRandom.h"
+
+using namespace std;
+using namespace chrono;
+
+// Lazy pipelines: a source and its stages compose at compile time into one
+// expression type. Evaluating element i pushes zero or one value down through
+// the stages into the reduction, so the whole pipeline runs as a single
+// parallel loop and no intermediate array is ever written.
+
+struct Expression {};
+
+template <typename E>
+using IsExpression = enable_if_t<is_base_of<Expression, decay_t<E>>::value, int>;
+
+template <typename F>
+struct Generate : Expression {
+    long long n;
+    F f;
+    Generate(long long n, F f) : n(n), f(f) {}
+    long long size() const { return n; }
+    template <typename Sink>
+    void eval(long long i, Sink&& sink) const { sink(f(i)); }
+};
+
+template <typename T>
+struct FromVector : Expression {
+    const vector<T>* v;
+    explicit FromVector(const vector<T>& v) : v(&v) {}
+    long long size() const { return v->size(); }
+    template <typename Sink>
+    void eval(long long i, Sink&& sink) const { sink((*v)[i]); }
+};
+
+template <typename Src, typename F>
+struct Map : Expression {
+    Src src;
+    F f;
+    Map(Src src, F f) : src(src), f(f) {}
+    long long size() const { return src.size(); }
+    template <typename Sink>
+    void eval(long long i, Sink&& sink) const {
+        src.eval(i, [&](auto v) { sink(f(v)); });
+    }
+};
+
+template <typename Src, typename P>
+struct Filter : Expression {
+    Src src;
+    P p;
+    Filter(Src src, P p) : src(src), p(p) {}
+    long long size() const { return src.size(); }
+    template <typename Sink>
+    void eval(long long i, Sink&& sink) const {
+        src.eval(i, [&](auto v) { if (p(v)) sink(v); });
+    }
+};
+
+template <typename F> struct MapStage { F f; };
+template <typename P> struct FilterStage { P p; };
+
+template <typename F>
+Generate<F> generate(long long n, F f) { return Generate<F>(n, f); }
+
+template <typename T>
+FromVector<T> from(const vector<T>& v) { return FromVector<T>(v); }
+
+// The values fillUniformInt would store, generated on demand.
+inline auto uniformInts(long long n, int lo, int hi, uint64_t seed) {
+    return generate(n, UniformInt<>(lo, hi, seed));
+}
+
+template <typename F> MapStage<F> mapWith(F f) { return {f}; }
+template <typename P> FilterStage<P> filter(P p) { return {p}; }
+
+template <typename Src, typename F, IsExpression<Src> = 0>
+Map<Src, F> operator|(Src src, MapStage<F> stage) { return Map<Src, F>(src, stage.f); }
+
+template <typename Src, typename P, IsExpression<Src> = 0>
+Filter<Src, P> operator|(Src src, FilterStage<P> stage) { return Filter<Src, P>(src, stage.p); }
+
+// Reductions supply an identity, an accumulate step and a combine step for
+// per-thread partial results, like an OpenMP declare reduction.
+struct PipelineStats {
+    long long count = 0;
+    long long minVal = LLONG_MAX;
+    long long maxVal = LLONG_MIN;
+    long long sum = 0;
+    double average() const { return count ? static_cast<double>(sum) / count : 0.0; }
+};
+
+struct StatsReduction {
+    using Result = PipelineStats;
+    Result identity() const { return Result(); }
+    template <typename V>
+    void accumulate(Result& r, V v) const {
+        ++r.count;
+        r.minVal = min<long long>(r.minVal, v);
+        r.maxVal = max<long long>(r.maxVal, v);
+        r.sum += v;
+    }
+    void combine(Result& r, const Result& o) const {
+        r.count += o.count;
+        r.minVal = min(r.minVal, o.minVal);
+        r.maxVal = max(r.maxVal, o.maxVal);
+        r.sum += o.sum;
+    }
+};
+
+template <typename T>
+struct SumReduction {
+    using Result = T;
+    Result identity() const { return T(); }
+    template <typename V>
+    void accumulate(Result& r, V v) const { r += v; }
+    void combine(Result& r, const Result& o) const { r += o; }
+};
+
+template <typename T>
+struct MinReduction {
+    using Result = T;
+    Result identity() const { return numeric_limits<T>::max(); }
+    template <typename V>
+    void accumulate(Result& r, V v) const { r = min<T>(r, v); }
+    void combine(Result& r, const Result& o) const { r = min(r, o); }
+};
+
+template <typename T>
+struct MaxReduction {
+    using Result = T;
+    Result identity() const { return numeric_limits<T>::lowest(); }
+    template <typename V>
+    void accumulate(Result& r, V v) const { r = max<T>(r, v); }
+    void combine(Result& r, const Result& o) const { r = max(r, o); }
+};
+
+template <typename R> struct ReduceStage { R r; };
+
+inline ReduceStage<StatsReduction> stats() { return {StatsReduction()}; }
+template <typename T = long long> ReduceStage<SumReduction<T>> sum() { return {SumReduction<T>()}; }
+template <typename T = long long> ReduceStage<MinReduction<T>> minimum() { return {MinReduction<T>()}; }
+template <typename T = long long> ReduceStage<MaxReduction<T>> maximum() { return {MaxReduction<T>()}; }
+
+template <typename Src, typename R, IsExpression<Src> = 0>
+typename R::Result operator|(const Src& src, ReduceStage<R> stage) {
+    const R& red = stage.r;
+    long long n = src.size();
+    typename R::Result total = red.identity();
+
+    #pragma omp parallel
+    {
+        typename R::Result local = red.identity();
+
+        #pragma omp for schedule(static) nowait
+        for (long long i = 0; i < n; ++i)
+            src.eval(i, [&](auto v) { red.accumulate(local, v); });
+
+        #pragma omp critical
+        red.combine(total, local);
+    }
+    return total;
+}
+
+// The same pipeline with every stage materialized, for comparison.
+PipelineStats materializedPipeline(long long n, uint64_t seed) {
+    vector<int> generated(n);
+    fillUniformInt(generated, 0, 9999, seed);
+
+    vector<long long> mapped(n);
+    #pragma omp parallel for
+    for (long long i = 0; i < n; ++i)
+        mapped[i] = (long long)generated[i] * generated[i] % 10007;
+
+    vector<long long> filtered;
+    for (long long v : mapped)
+        if (v % 3 == 0) filtered.push_back(v);
+
+    long long minVal = LLONG_MAX, maxVal = LLONG_MIN, total = 0;
+    #pragma omp parallel for reduction(min:minVal) reduction(max:maxVal) reduction(+:total)
+    for (long long i = 0; i < (long long)filtered.size(); ++i) {
+        minVal = min(minVal, filtered[i]);
+        maxVal = max(maxVal, filtered[i]);
+        total += filtered[i];
+    }
+
+    PipelineStats s;
+    s.count = filtered.size();
+    s.minVal = minVal;
+    s.maxVal = maxVal;
+    s.sum = total;
+    return s;
+}
+
+int main() {
+    const long long SIZE = 100000000;
+    const uint64_t SEED = 2024;
+
+    auto start = high_resolution_clock::now();
+    PipelineStats materialized = materializedPipeline(SIZE, SEED);
+    auto end = high_resolution_clock::now();
+    long long materializedTime = duration_cast<milliseconds>(end - start).count();
+
+    start = high_resolution_clock::now();
+    PipelineStats fused = uniformInts(SIZE, 0, 9999, SEED)
+                        | mapWith([](int x) { return (long long)x * x % 10007; })
+                        | filter([](long long x) { return x % 3 == 0; })
+                        | stats();
+    end = high_resolution_clock::now();
+    long long fusedTime = duration_cast<milliseconds>(end - start).count();
+
+    vector<int> data(SIZE);
+    fillUniformInt(data, 0, 9999, SEED);
+    long long evenSum = from(data) | filter([](int x) { return x % 2 == 0; }) | sum();
+    double largestRoot = from(data) | mapWith([](int x) { return sqrt((double)x); }) | maximum<double>();
+
+    bool ok = fused.count == materialized.count && fused.sum == materialized.sum &&
+              fused.minVal == materialized.minVal && fused.maxVal == materialized.maxVal;
+
+    cout << "Pipeline: generate -> x*x mod 10007 -> keep multiples of 3 -> min/max/sum\n";
+    cout << "Materialized Time: " << materializedTime << " ms\n";
+    cout << "Fused Time: " << fusedTime << " ms\n";
+    cout << "Count: " << fused.count << "\n";
+    cout << "Min: " << fused.minVal << "\n";
+    cout << "Max: " << fused.maxVal << "\n";
+    cout << "Sum: " << fused.sum << "\n";
+    cout << "Average: " << fused.average() << "\n";
+    cout << "Sum of even values in HPC3 data: " << evenSum << "\n";
+    cout << "Largest square root in HPC3 data: " << largestRoot << "\n";
+    cout << "Correct: " << (ok ? "yes" : "no") << "\n";
+
+    return 0;
+}
@@ -0,0 +1,350 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <omp.h>
+#include "ParallelRandom.h"
+
+using namespace std;
+using namespace chrono;
+
+// A wanted rank and where its value goes in the output.
+struct RankSlot {
+    long long rank;
+    int slot;
+};
+
+// Resolves ranks (sorted) inside a small array by successive nth_element calls,
+// each one on the part to the right of the previous rank.
+template <typename T>
+void selectSmall(vector<T>& values, const vector<RankSlot>& ranks, vector<T>& out) {
+    auto from = values.begin();
+    for (const RankSlot& r : ranks) {
+        nth_element(from, values.begin() + r.rank, values.end());
+        out[r.slot] = values[r.rank];
+        from = values.begin() + r.rank;
+    }
+}
+
+const int RADIX_BITS = 11;
+const long long SMALL_SELECT = 1 << 16;
+
+struct IntKeys {
+    const int* data;
+    int base;
+    uint32_t operator()(long long i) const { return (uint32_t)data[i] - (uint32_t)base; }
+};
+
+struct ArrayKeys {
+    const uint32_t* data;
+    uint32_t operator()(long long i) const { return data[i]; }
+};
+
+// Histogram-based radix select over unsigned keys that agree above their low
+// `bits` bits. One parallel pass histograms the next RADIX_BITS-bit digit, the
+// prefix sums locate the bucket of every wanted rank, and a second pass gathers
+// just those buckets, in which the search continues on the remaining bits.
+// Every rank is served by the same passes, so q quantiles cost O(n) in total.
+template <typename Keys>
+void radixSelect(long long n, Keys keyOf, int bits, const vector<RankSlot>& ranks, vector<uint32_t>& out) {
+    if (bits == 0) {
+        for (const RankSlot& r : ranks)
+            out[r.slot] = keyOf(0);
+        return;
+    }
+    if (n <= SMALL_SELECT) {
+        vector<uint32_t> keys(n);
+        for (long long i = 0; i < n; ++i)
+            keys[i] = keyOf(i);
+        selectSmall(keys, ranks, out);
+        return;
+    }
+
+    int digitBits = min(RADIX_BITS, bits);
+    int shift = bits - digitBits;
+    int buckets = 1 << digitBits;
+    uint32_t mask = buckets - 1;
+    int nthreads = omp_get_max_threads();
+    vector<long long> threadCounts((size_t)nthreads * buckets, 0);
+    vector<long long> start(buckets + 1, 0);
+    vector<int> target(buckets, -1);
+    vector<int> targetBucket;
+    vector<vector<RankSlot>> targetRanks;
+    vector<vector<uint32_t>> gathered;
+
+    // Count and gather run in one region: the gather gives every thread its
+    // exclusive range of each target bucket from that thread's own counts, so
+    // both passes must see the same team and the same static chunks.
+    #pragma omp parallel num_threads(nthreads)
+    {
+        int t = omp_get_thread_num();
+        long long* mine = &threadCounts[(size_t)t * buckets];
+        #pragma omp for schedule(static)
+        for (long long i = 0; i < n; ++i)
+            ++mine[(keyOf(i) >> shift) & mask];
+
+        // Groups the ranks by the bucket they fall in.
+        #pragma omp single
+        {
+            for (int b = 0; b < buckets; ++b) {
+                long long total = 0;
+                for (int u = 0; u < nthreads; ++u)
+                    total += threadCounts[(size_t)u * buckets + b];
+                start[b + 1] = start[b] + total;
+            }
+            for (const RankSlot& r : ranks) {
+                int b = upper_bound(start.begin(), start.end(), r.rank) - start.begin() - 1;
+                if (target[b] < 0) {
+                    target[b] = targetBucket.size();
+                    targetBucket.push_back(b);
+                    targetRanks.emplace_back();
+                }
+                targetRanks[target[b]].push_back({r.rank - start[b], r.slot});
+            }
+            gathered.resize(targetBucket.size());
+            for (size_t j = 0; j < targetBucket.size(); ++j)
+                gathered[j].resize(start[targetBucket[j] + 1] - start[targetBucket[j]]);
+        }
+
+        int targets = targetBucket.size();
+        vector<uint32_t*> cursor(targets);
+        for (int j = 0; j < targets; ++j) {
+            long long offset = 0;
+            for (int u = 0; u < t; ++u)
+                offset += threadCounts[(size_t)u * buckets + targetBucket[j]];
+            cursor[j] = gathered[j].data() + offset;
+        }
+
+        #pragma omp for schedule(static)
+        for (long long i = 0; i < n; ++i) {
+            uint32_t key = keyOf(i);
+            int j = target[(key >> shift) & mask];
+            if (j >= 0) *cursor[j]++ = key;
+        }
+    }
+
+    int targets = targetBucket.size();
+    for (int j = 0; j < targets; ++j)
+        radixSelect(gathered[j].size(), ArrayKeys{gathered[j].data()}, shift, targetRanks[j], out);
+}
+
+vector<int> selectRanks(const vector<int>& data, const vector<RankSlot>& ranks) {
+    long long n = data.size();
+    int minVal = INT_MAX, maxVal = INT_MIN;
+    #pragma omp parallel for reduction(min:minVal) reduction(max:maxVal)
+    for (long long i = 0; i < n; ++i) {
+        minVal = min(minVal, data[i]);
+        maxVal = max(maxVal, data[i]);
+    }
+
+    // Keys are offsets from the minimum, so only the bits the range needs are walked.
+    uint32_t range = (uint32_t)maxVal - (uint32_t)minVal;
+    int bits = range ? 32 - __builtin_clz(range) : 0;
+    vector<uint32_t> keys(ranks.size());
+    radixSelect(n, IntKeys{data.data(), minVal}, bits, ranks, keys);
+
+    vector<int> values(ranks.size());
+    for (size_t s = 0; s < keys.size(); ++s)
+        values[s] = (int)(keys[s] + (uint32_t)minVal);
+    return values;
+}
+
+// Sample-based select (Floyd-Rivest): the position of rank k in a sorted random
+// sample brackets its value between two sample elements with high probability.
+// Overlapping brackets are merged, and one parallel pass classifies every
+// element against the sorted bracket bounds without branches, counting each
+// region and gathering the elements inside a bracket. Each rank is then
+// resolved among the few gathered ones. A bracket that misses is widened to
+// the open side and the pass repeated. Data must not contain NaN.
+vector<double> selectRanks(const vector<double>& data, const vector<RankSlot>& ranks) {
+    const long long SAMPLE = 1 << 16;
+    const double INF = numeric_limits<double>::infinity();
+    const uint64_t SAMPLE_SEED = 0x73616d706c65ULL;
+    long long n = data.size();
+    long long s = min(n, SAMPLE);
+    int q = ranks.size();
+
+    vector<double> sample(s);
+    for (long long i = 0; i < s; ++i)
+        sample[i] = data[toBounded(SplitMix64::bits(SAMPLE_SEED, i), n)];
+    sort(sample.begin(), sample.end());
+
+    vector<double> lo(q), hi(q);
+    long long margin = (long long)(3 * sqrt((double)s)) + 1;
+    for (int j = 0; j < q; ++j) {
+        long long pos = (long long)((double)ranks[j].rank / n * s);
+        lo[j] = pos - margin < 0 ? -INF : sample[pos - margin];
+        hi[j] = pos + margin >= s ? INF : sample[pos + margin];
+    }
+
+    vector<double> out(q);
+    vector<int> pending(q);
+    for (int j = 0; j < q; ++j)
+        pending[j] = j;
+
+    while (!pending.empty()) {
+        // Widened brackets can break the order, so sort by lower bound and merge
+        // the overlapping ones.
+        sort(pending.begin(), pending.end(), [&](int a, int b) { return lo[a] < lo[b]; });
+        vector<double> lower, upper;
+        vector<int> interval(pending.size());
+        for (size_t j = 0; j < pending.size(); ++j) {
+            int r = pending[j];
+            if (lower.empty() || lo[r] > upper.back()) {
+                lower.push_back(lo[r]);
+                upper.push_back(hi[r]);
+            } else {
+                upper.back() = max(upper.back(), hi[r]);
+            }
+            interval[j] = lower.size() - 1;
+        }
+        int intervals = lower.size();
+        int regions = 2 * intervals + 1;
+        vector<long long> counts(regions, 0);
+        vector<vector<double>> inside(intervals);
+
+        // Region 2m + 1 is inside interval m; the even regions lie between intervals.
+        #pragma omp parallel
+        {
+            vector<long long> myCounts(regions, 0);
+            vector<vector<double>> myInside(intervals);
+
+            #pragma omp for schedule(static) nowait
+            for (long long i = 0; i < n; ++i) {
+                double x = data[i];
+                int region = 0;
+                for (int m = 0; m < intervals; ++m)
+                    region += (x >= lower[m]) + (x > upper[m]);
+                ++myCounts[region];
+                if (region & 1) myInside[region >> 1].push_back(x);
+            }
+
+            #pragma omp critical
+            for (int r = 0; r < regions; ++r) {
+                counts[r] += myCounts[r];
+                if (r & 1) inside[r >> 1].insert(inside[r >> 1].end(), myInside[r >> 1].begin(), myInside[r >> 1].end());
+            }
+        }
+
+        vector<long long> below(intervals, 0);
+        long long seen = 0;
+        for (int r = 0; r < regions; ++r) {
+            if (r & 1) below[r >> 1] = seen;
+            seen += counts[r];
+        }
+
+        vector<int> missed;
+        vector<vector<RankSlot>> local(intervals);
+        for (size_t j = 0; j < pending.size(); ++j) {
+            int r = pending[j], m = interval[j];
+            long long k = ranks[r].rank - below[m];
+            if (k < 0) {
+                lo[r] = -INF;
+                missed.push_back(r);
+            } else if (k >= (long long)inside[m].size()) {
+                hi[r] = INF;
+                missed.push_back(r);
+            } else {
+                local[m].push_back({k, ranks[r].slot});
+            }
+        }
+        for (int m = 0; m < intervals; ++m) {
+            sort(local[m].begin(), local[m].end(), [](const RankSlot& a, const RankSlot& b) { return a.rank < b.rank; });
+            if (!local[m].empty()) selectSmall(inside[m], local[m], out);
+        }
+        pending = missed;
+    }
+    return out;
+}
+
+// Quantile q is interpolated between ranks floor(q * (n - 1)) and the next one,
+// so the 0.5 quantile is the usual median for even n as well. An empty input
+// has no quantiles; every one comes back as NaN.
+template <typename T>
+vector<double> parallelQuantiles(const vector<T>& data, const vector<double>& qs) {
+    long long n = data.size();
+    if (n == 0) return vector<double>(qs.size(), numeric_limits<double>::quiet_NaN());
+    vector<long long> wanted;
+    for (double q : qs) {
+        long long r = (long long)floor(q * (n - 1));
+        wanted.push_back(r);
+        wanted.push_back(min(r + 1, n - 1));
+    }
+    sort(wanted.begin(), wanted.end());
+    wanted.erase(unique(wanted.begin(), wanted.end()), wanted.end());
+
+    vector<RankSlot> ranks;
+    for (size_t s = 0; s < wanted.size(); ++s)
+        ranks.push_back({wanted[s], (int)s});
+    vector<T> values = selectRanks(data, ranks);
+
+    vector<double> result;
+    for (double q : qs) {
+        double h = q * (n - 1);
+        long long r = (long long)floor(h);
+        size_t a = lower_bound(wanted.begin(), wanted.end(), r) - wanted.begin();
+        size_t b = lower_bound(wanted.begin(), wanted.end(), min(r + 1, n - 1)) - wanted.begin();
+        result.push_back(values[a] + (h - r) * ((double)values[b] - values[a]));
+    }
+    return result;
+}
+
+template <typename T>
+vector<double> sortedQuantiles(vector<T> data, const vector<double>& qs) {
+    sort(data.begin(), data.end());
+    long long n = data.size();
+    vector<double> result;
+    for (double q : qs) {
+        double h = q * (n - 1);
+        long long r = (long long)floor(h);
+        result.push_back(data[r] + (h - r) * ((double)data[min(r + 1, n - 1)] - data[r]));
+    }
+    return result;
+}
+
+template <typename T>
+void compareQuantiles(const char* label, const vector<T>& data, const vector<double>& qs) {
+    auto start = high_resolution_clock::now();
+    vector<double> expected = sortedQuantiles(data, qs);
+    auto end = high_resolution_clock::now();
+    long long sortTime = duration_cast<milliseconds>(end - start).count();
+
+    start = high_resolution_clock::now();
+    vector<double> selected = parallelQuantiles(data, qs);
+    end = high_resolution_clock::now();
+    long long selectTime = duration_cast<milliseconds>(end - start).count();
+
+    cout << label << ":\n";
+    cout << "  Sort Time: " << sortTime << " ms\n";
+    cout << "  Selection Time: " << selectTime << " ms\n";
+    for (size_t j = 0; j < qs.size(); ++j)
+        cout << "  q" << qs[j] << ": " << selected[j] << "\n";
+    cout << "  Correct: " << (selected == expected ? "yes" : "no") << "\n";
+}
+
+int main() {
+    const int SIZE = 100000000;
+    const uint64_t SEED = 2024;
+    const vector<double> QUANTILES = {0.0, 0.01, 0.25, 0.5, 0.75, 0.99, 0.999, 1.0};
+
+    vector<int> data(SIZE), skewed(SIZE);
+    vector<double> normal(SIZE);
+    fillUniformInt(data, 0, 9999, SEED);
+    fillZipf(skewed, 1000000, 1.1, SEED);
+    fillNormal(normal, 0.0, 1.0, SEED);
+
+    compareQuantiles("Uniform ints", data, QUANTILES);
+    compareQuantiles("Zipf ints", skewed, QUANTILES);
+    compareQuantiles("Normal doubles", normal, QUANTILES);
+
+    bool emptyOk = true;
+    for (double v : parallelQuantiles(vector<int>(), QUANTILES))
+        emptyOk = emptyOk && isnan(v);
+    cout << "Empty Input Gives NaN: " << (emptyOk ? "yes" : "no") << "\n";
+
+    return 0;
+}
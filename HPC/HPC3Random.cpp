@@ -0,0 +1,72 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <cmath>
+#include <omp.h>
+#include "ParallelRandom.h"
+
+using namespace std;
+using namespace chrono;
+
+template <typename T>
+unsigned long long checksum(const vector<T>& v) {
+    unsigned long long h = 0;
+    for (size_t i = 0; i < v.size(); ++i)
+        h = h * 1000003 + (unsigned long long)v[i];
+    return h;
+}
+
+int main() {
+    const int SIZE = 20000000;
+    const uint64_t SEED = 2024;
+    const int THREAD_COUNTS[] = {1, 2, 4, 8};
+    vector<int> data(SIZE);
+
+    auto start = high_resolution_clock::now();
+    srand(time(0));
+    for (int i = 0; i < SIZE; ++i)
+        data[i] = rand() % 10000;
+    auto end = high_resolution_clock::now();
+    cout << "Serial rand() Fill Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+
+    start = high_resolution_clock::now();
+    fillUniformInt(data, 0, 9999, SEED);
+    end = high_resolution_clock::now();
+    cout << "SplitMix64 Fill Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+
+    start = high_resolution_clock::now();
+    fillUniformInt<Philox4x32>(data, 0, 9999, SEED);
+    end = high_resolution_clock::now();
+    cout << "Philox4x32 Fill Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+
+    cout << "Checksums by thread count:";
+    for (int threads : THREAD_COUNTS) {
+        omp_set_num_threads(threads);
+        fillUniformInt(data, 0, 9999, SEED);
+        cout << " " << threads << "=" << hex << checksum(data) << dec;
+    }
+    cout << "\n";
+
+    vector<double> normal(SIZE);
+    fillNormal(normal, 5.0, 2.0, SEED);
+    double mean = 0, sq = 0;
+    #pragma omp parallel for reduction(+:mean, sq)
+    for (int i = 0; i < SIZE; ++i) {
+        mean += normal[i];
+        sq += normal[i] * normal[i];
+    }
+    mean /= SIZE;
+    cout << "Normal(5, 2) Sample Mean: " << mean << ", Stddev: " << sqrt(sq / SIZE - mean * mean) << "\n";
+
+    vector<int> zipf(SIZE);
+    fillZipf(zipf, 10000, 1.1, SEED);
+    long long ones = 0;
+    #pragma omp parallel for reduction(+:ones)
+    for (int i = 0; i < SIZE; ++i)
+        ones += zipf[i] == 1;
+    cout << "Zipf(10000, 1.1) Share of Rank 1: " << (double)ones / SIZE << "\n";
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+#include <omp.h>
+#include "ParallelRandom.h"
+
+using namespace std;
+using namespace chrono;
+
+struct MinOp {
+    static constexpr int identity = INT_MAX;
+    int operator()(int a, int b) const { return min(a, b); }
+    static bool before(int a, int b) { return a < b; }
+};
+
+struct MaxOp {
+    static constexpr int identity = INT_MIN;
+    int operator()(int a, int b) const { return max(a, b); }
+    static bool before(int a, int b) { return a > b; }
+};
+
+// Range min/max on static data in O(1) per query and under two words per
+// element. The array is cut into blocks of 32:
+// - inside a block, mask[i] records which of the block's positions up to i are
+//   still on the monotonic stack after pushing i, so the answer for [l, i]
+//   is the lowest stack position at or after l, one ctz away;
+// - across blocks, a sparse table over the block aggregates answers any run
+//   of whole blocks with two overlapping power-of-two lookups.
+// Both parts are built in parallel. The data is referenced, not copied, and
+// must outlive the index.
+template <typename Op>
+class RangeExtremum {
+public:
+    static const int B = 32;
+
+    explicit RangeExtremum(const vector<int>& data) : data(data) {
+        long long n = data.size();
+        long long blocks = (n + B - 1) / B;
+        mask.resize(n);
+        table.emplace_back(blocks);
+
+        #pragma omp parallel for schedule(static)
+        for (long long b = 0; b < blocks; ++b) {
+            long long start = b * B;
+            int len = min<long long>(B, n - start);
+            uint32_t stack = 0;
+            for (int i = 0; i < len; ++i) {
+                while (stack && !Op::before(data[start + 31 - __builtin_clz(stack)], data[start + i]))
+                    stack &= ~(1u << (31 - __builtin_clz(stack)));
+                stack |= 1u << i;
+                mask[start + i] = stack;
+            }
+            table[0][b] = data[start + __builtin_ctz(stack)];
+        }
+
+        for (int k = 1; (1LL << k) <= blocks; ++k) {
+            const vector<int>& prev = table[k - 1];
+            long long half = 1LL << (k - 1);
+            vector<int> level(blocks - (1LL << k) + 1);
+            #pragma omp parallel for simd schedule(static)
+            for (long long b = 0; b < (long long)level.size(); ++b)
+                level[b] = op(prev[b], prev[b + half]);
+            table.push_back(move(level));
+        }
+    }
+
+    // Aggregate of data[l, r), for l < r.
+    int query(long long l, long long r) const {
+        --r;
+        long long bl = l / B, br = r / B;
+        if (bl == br) return inBlock(l, r);
+        int result = op(inBlock(l, bl * B + B - 1), inBlock(br * B, r));
+        if (bl + 1 < br) result = op(result, blockRange(bl + 1, br - 1));
+        return result;
+    }
+
+    vector<int> queryBatch(const vector<pair<long long, long long>>& ranges) const {
+        vector<int> out(ranges.size());
+        #pragma omp parallel for schedule(static)
+        for (long long q = 0; q < (long long)ranges.size(); ++q)
+            out[q] = query(ranges[q].first, ranges[q].second);
+        return out;
+    }
+
+private:
+    // data[l..r] with l and r in the same block.
+    int inBlock(long long l, long long r) const {
+        long long start = l / B * B;
+        return data[start + __builtin_ctz(mask[r] & (~0u << (l - start)))];
+    }
+
+    // Whole blocks bl..br.
+    int blockRange(long long bl, long long br) const {
+        int k = 63 - __builtin_clzll(br - bl + 1);
+        return op(table[k][bl], table[k][br - (1LL << k) + 1]);
+    }
+
+    const vector<int>& data;
+    vector<uint32_t> mask;
+    vector<vector<int>> table;
+    Op op;
+};
+
+int main() {
+    const int SIZE = 100000000;
+    const int QUERIES = 10000000;
+    const int CHECKS = 200;
+    const uint64_t SEED = 2024;
+    vector<int> data(SIZE);
+
+    fillUniformInt(data, 0, 9999, SEED);
+
+    auto start = high_resolution_clock::now();
+    RangeExtremum<MinOp> minIndex(data);
+    RangeExtremum<MaxOp> maxIndex(data);
+    auto end = high_resolution_clock::now();
+    cout << "Build Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+
+    int minVal = data[0], maxVal = data[0];
+    #pragma omp parallel for reduction(min:minVal) reduction(max:maxVal)
+    for (int i = 0; i < SIZE; ++i) {
+        if (data[i] < minVal) minVal = data[i];
+        if (data[i] > maxVal) maxVal = data[i];
+    }
+    cout << "Full Array: Min " << minIndex.query(0, SIZE) << ", Max " << maxIndex.query(0, SIZE)
+         << " (reduction: " << minVal << ", " << maxVal << ")\n";
+
+    // Short ranges stress the in-block masks, long ones the sparse table.
+    const long long MAX_LENGTHS[] = {64, SIZE};
+    for (long long maxLength : MAX_LENGTHS) {
+        vector<long long> starts(QUERIES), lengths(QUERIES);
+        fillUniformInt(starts, 0LL, (long long)SIZE - 1, SEED + 1);
+        fillUniformInt(lengths, 1LL, maxLength, SEED + 2);
+        vector<pair<long long, long long>> ranges(QUERIES);
+        for (int q = 0; q < QUERIES; ++q)
+            ranges[q] = {starts[q], min<long long>(starts[q] + lengths[q], SIZE)};
+
+        start = high_resolution_clock::now();
+        vector<int> mins = minIndex.queryBatch(ranges);
+        vector<int> maxs = maxIndex.queryBatch(ranges);
+        end = high_resolution_clock::now();
+        double ms = duration<double, milli>(end - start).count();
+
+        bool ok = true;
+        for (int q = 0; q < CHECKS; ++q) {
+            int lo = INT_MAX, hi = INT_MIN;
+            for (long long i = ranges[q].first; i < ranges[q].second; ++i) {
+                lo = min(lo, data[i]);
+                hi = max(hi, data[i]);
+            }
+            ok = ok && lo == mins[q] && hi == maxs[q];
+        }
+
+        cout << "Ranges up to " << maxLength << " elements: " << ms << " ms for " << QUERIES
+             << " min/max query pairs (" << ms * 1e6 / (2.0 * QUERIES) << " ns/query)\n";
+        cout << "Correct: " << (ok ? "yes" : "no") << "\n";
+    }
+
+    return 0;
+}
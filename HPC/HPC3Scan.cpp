@@ -0,0 +1,73 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <algorithm>
+#include <omp.h>
+#include "ParallelRandom.h"
+#include "ParallelScan.h"
+
+using namespace std;
+using namespace chrono;
+
+template <typename T, typename Op = plus<T>>
+void sequentialInclusiveScan(const vector<T>& in, vector<T>& out, T identity = T(), Op op = Op()) {
+    out.resize(in.size());
+    T acc = identity;
+    for (size_t i = 0; i < in.size(); ++i) {
+        acc = op(acc, in[i]);
+        out[i] = acc;
+    }
+}
+
+int main() {
+    const int SIZE = 50000000;
+    const uint64_t SEED = 2024;
+    vector<long long> data(SIZE);
+
+    fillUniformInt(data, 0LL, 9999LL, SEED);
+
+    vector<long long> expected(SIZE), blocked(SIZE), lookback(SIZE), exclusive(SIZE), copy(SIZE);
+
+    auto start = high_resolution_clock::now();
+    memcpy(copy.data(), data.data(), SIZE * sizeof(long long));
+    auto end = high_resolution_clock::now();
+    double memcpyTime = duration<double>(end - start).count();
+
+    start = high_resolution_clock::now();
+    sequentialInclusiveScan(data, expected);
+    end = high_resolution_clock::now();
+    double seqTime = duration<double>(end - start).count();
+
+    start = high_resolution_clock::now();
+    inclusiveScan(data, blocked);
+    end = high_resolution_clock::now();
+    double blockedTime = duration<double>(end - start).count();
+
+    start = high_resolution_clock::now();
+    lookbackScan(data, lookback);
+    end = high_resolution_clock::now();
+    double lookbackTime = duration<double>(end - start).count();
+
+    exclusiveScan(data, exclusive);
+
+    vector<long long> runningMax;
+    inclusiveScan(data, runningMax, 0LL, [](long long a, long long b) { return max(a, b); });
+
+    bool ok = blocked == expected && lookback == expected && exclusive[0] == 0;
+    for (int i = 1; i < SIZE && ok; ++i)
+        ok = exclusive[i] == expected[i - 1];
+    ok = ok && runningMax.back() == *max_element(data.begin(), data.end());
+
+    double bytes = 2.0 * SIZE * sizeof(long long);
+    cout << "Parallel Scan Results:\n";
+    cout << "Total: " << expected.back() << "\n";
+    cout << "Correct: " << (ok ? "yes" : "no") << "\n";
+    cout << "memcpy: " << memcpyTime * 1000 << " ms (" << bytes / memcpyTime / 1e9 << " GB/s)\n";
+    cout << "Sequential Scan: " << seqTime * 1000 << " ms (" << bytes / seqTime / 1e9 << " GB/s)\n";
+    cout << "Blocked Scan: " << blockedTime * 1000 << " ms (" << bytes / blockedTime / 1e9 << " GB/s)\n";
+    cout << "Look-back Scan: " << lookbackTime * 1000 << " ms (" << bytes / lookbackTime / 1e9 << " GB/s)\n";
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <algorithm>
+#include <omp.h>
+#include "ParallelRandom.h"
+#include "ParallelScan.h"
+
+using namespace std;
+using namespace chrono;
+
+// scan() folds a short run; each Op names its own simd reduction, since
+// OpenMP has no reduction clause for an arbitrary functor.
+struct MinOp {
+    static constexpr int identity = INT_MAX;
+    int operator()(int a, int b) const { return min(a, b); }
+
+    static int scan(const int* v, long long len) {
+        int acc = identity;
+        #pragma omp simd reduction(min:acc)
+        for (long long i = 0; i < len; ++i)
+            acc = min(acc, v[i]);
+        return acc;
+    }
+};
+
+struct MaxOp {
+    static constexpr int identity = INT_MIN;
+    int operator()(int a, int b) const { return max(a, b); }
+
+    static int scan(const int* v, long long len) {
+        int acc = identity;
+        #pragma omp simd reduction(max:acc)
+        for (long long i = 0; i < len; ++i)
+            acc = max(acc, v[i]);
+        return acc;
+    }
+};
+
+// B-ary segment tree: every node has B = 16 children stored contiguously (one
+// cache line of ints), so each level visited costs at most two SIMD scans of
+// B elements. Level 0 holds the data, level k holds aggregates of B^k elements.
+template <typename Op>
+class SegmentTree {
+public:
+    static const int B = 16;
+
+    explicit SegmentTree(const vector<int>& data) {
+        long long n = data.size();
+        levels.emplace_back(roundUp(n), Op::identity);
+        #pragma omp parallel for simd schedule(static)
+        for (long long i = 0; i < n; ++i)
+            levels[0][i] = data[i];
+
+        while (levels.back().size() > B) {
+            const vector<int>& below = levels.back();
+            vector<int> above(roundUp(below.size() / B), Op::identity);
+            long long parents = below.size() / B;
+            #pragma omp parallel for schedule(static)
+            for (long long p = 0; p < parents; ++p)
+                above[p] = scan(below.data() + p * B, B);
+            levels.push_back(move(above));
+        }
+    }
+
+    // Aggregate of data[l, r).
+    int query(long long l, long long r) const {
+        int result = Op::identity;
+        for (size_t level = 0; l < r; ++level) {
+            const int* v = levels[level].data();
+            if (l / B == (r - 1) / B) {
+                result = op(result, scan(v + l, r - l));
+                break;
+            }
+            long long lEnd = (l + B - 1) / B * B;
+            long long rBegin = r / B * B;
+            result = op(result, scan(v + l, lEnd - l));
+            result = op(result, scan(v + rBegin, r - rBegin));
+            l = lEnd / B;
+            r = rBegin / B;
+        }
+        return result;
+    }
+
+    void update(long long i, int value) {
+        levels[0][i] = value;
+        for (size_t level = 1; level < levels.size(); ++level) {
+            i /= B;
+            levels[level][i] = scan(levels[level - 1].data() + i * B, B);
+        }
+    }
+
+    vector<int> queryBatch(const vector<pair<long long, long long>>& ranges) const {
+        vector<int> out(ranges.size());
+        #pragma omp parallel for schedule(static)
+        for (long long q = 0; q < (long long)ranges.size(); ++q)
+            out[q] = query(ranges[q].first, ranges[q].second);
+        return out;
+    }
+
+private:
+    static long long roundUp(long long n) {
+        return max<long long>(B, (n + B - 1) / B * B);
+    }
+
+    static int scan(const int* v, long long len) {
+        return Op::scan(v, len);
+    }
+
+    Op op;
+    vector<vector<int>> levels;
+};
+
+// Fenwick tree over 1-based positions: tree[i] covers (i - lowbit(i), i]. Built
+// in parallel from one prefix sum, since tree[i] = P[i] - P[i - lowbit(i)].
+class FenwickTree {
+public:
+    explicit FenwickTree(const vector<int>& data) {
+        long long n = data.size();
+        vector<long long> wide(n + 1, 0);
+        #pragma omp parallel for simd schedule(static)
+        for (long long i = 0; i < n; ++i)
+            wide[i + 1] = data[i];
+        vector<long long> prefix;
+        inclusiveScan(wide, prefix);
+
+        tree.assign(n + 1, 0);
+        #pragma omp parallel for simd schedule(static)
+        for (long long i = 1; i <= n; ++i)
+            tree[i] = prefix[i] - prefix[i - (i & -i)];
+    }
+
+    void add(long long i, long long delta) {
+        for (++i; i < (long long)tree.size(); i += i & -i)
+            tree[i] += delta;
+    }
+
+    // Sum of data[0, i).
+    long long prefixSum(long long i) const {
+        long long s = 0;
+        for (; i > 0; i -= i & -i)
+            s += tree[i];
+        return s;
+    }
+
+    long long query(long long l, long long r) const {
+        return prefixSum(r) - prefixSum(l);
+    }
+
+    vector<long long> queryBatch(const vector<pair<long long, long long>>& ranges) const {
+        vector<long long> out(ranges.size());
+        #pragma omp parallel for schedule(static)
+        for (long long q = 0; q < (long long)ranges.size(); ++q)
+            out[q] = query(ranges[q].first, ranges[q].second);
+        return out;
+    }
+
+private:
+    vector<long long> tree;
+};
+
+int main() {
+    const int SIZE = 10000000;
+    const int QUERIES = 1000000;
+    const int UPDATES = 100000;
+    const int CHECKS = 200;
+    const uint64_t SEED = 2024;
+    vector<int> data(SIZE);
+
+    fillUniformInt(data, 0, 9999, SEED);
+
+    auto start = high_resolution_clock::now();
+    SegmentTree<MinOp> minTree(data);
+    SegmentTree<MaxOp> maxTree(data);
+    FenwickTree sumTree(data);
+    auto end = high_resolution_clock::now();
+    cout << "Build Time: " << duration_cast<milliseconds>(end - start).count() << " ms\n";
+
+    vector<long long> positions(2 * QUERIES);
+    fillUniformInt(positions, 0LL, (long long)SIZE, SEED + 1);
+    vector<pair<long long, long long>> ranges(QUERIES);
+    for (int q = 0; q < QUERIES; ++q) {
+        long long a = positions[2 * q], b = positions[2 * q + 1];
+        ranges[q] = {min(a, b), min<long long>(max(a, b) + 1, SIZE)};
+    }
+
+    vector<int> updatePos(UPDATES), updateVal(UPDATES);
+    fillUniformInt(updatePos, 0, SIZE - 1, SEED + 2);
+    fillUniformInt(updateVal, 0, 9999, SEED + 3);
+
+    start = high_resolution_clock::now();
+    for (int u = 0; u < UPDATES; ++u) {
+        sumTree.add(updatePos[u], updateVal[u] - data[updatePos[u]]);
+        minTree.update(updatePos[u], updateVal[u]);
+        maxTree.update(updatePos[u], updateVal[u]);
+        data[updatePos[u]] = updateVal[u];
+    }
+    end = high_resolution_clock::now();
+    cout << "Update Time: " << duration_cast<milliseconds>(end - start).count() << " ms for " << UPDATES << " updates\n";
+
+    start = high_resolution_clock::now();
+    vector<int> mins = minTree.queryBatch(ranges);
+    vector<int> maxs = maxTree.queryBatch(ranges);
+    vector<long long> sums = sumTree.queryBatch(ranges);
+    end = high_resolution_clock::now();
+    cout << "Batched Query Time: " << duration_cast<milliseconds>(end - start).count() << " ms for " << QUERIES << " range min/max/sum queries\n";
+
+    bool ok = true;
+    for (int q = 0; q < CHECKS; ++q) {
+        long long l = ranges[q].first, r = ranges[q].second;
+        long long s = 0;
+        int lo = INT_MAX, hi = INT_MIN;
+        for (long long i = l; i < r; ++i) {
+            s += data[i];
+            lo = min(lo, data[i]);
+            hi = max(hi, data[i]);
+        }
+        ok = ok && s == sums[q] && lo == mins[q] && hi == maxs[q];
+    }
+    cout << "Correct: " << (ok ? "yes" : "no") << "\n";
+
+    return 0;
+}
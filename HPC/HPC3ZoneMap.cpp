@@ -0,0 +1,185 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+#include <omp.h>
+#include "ParallelRandom.h"
+#include "RangePredicate.h"
+
+using namespace std;
+using namespace chrono;
+
+struct QueryCounters {
+    long long skipped = 0;
+    long long taken = 0;
+    long long scanned = 0;
+};
+
+// Min, max and sum of every 4 KiB block of an int array. Queries answer whole
+// blocks from the summary when the predicate rejects or accepts all of them,
+// and only scan blocks that straddle a bound. The summary is only as useful
+// as the data is clustered: on shuffled data every block spans the full range.
+class ZoneMap {
+public:
+    static const long long BLOCK = 4096 / sizeof(int);
+
+    // Builds the zones in one parallel pass, which also yields the plain HPC3
+    // reduction of the whole array.
+    explicit ZoneMap(const vector<int>& data) : data(data) {
+        long long n = data.size();
+        long long blocks = (n + BLOCK - 1) / BLOCK;
+        zoneMin.resize(blocks);
+        zoneMax.resize(blocks);
+        zoneSum.resize(blocks);
+        int minVal = INT_MAX, maxVal = INT_MIN;
+        long long sum = 0;
+
+        #pragma omp parallel for schedule(static) reduction(min:minVal) reduction(max:maxVal) reduction(+:sum)
+        for (long long b = 0; b < blocks; ++b) {
+            const int* block = data.data() + b * BLOCK;
+            long long len = min(BLOCK, n - b * BLOCK);
+            int lo = INT_MAX, hi = INT_MIN;
+            long long s = 0;
+            #pragma omp simd reduction(min:lo) reduction(max:hi) reduction(+:s)
+            for (long long i = 0; i < len; ++i) {
+                lo = min(lo, block[i]);
+                hi = max(hi, block[i]);
+                s += block[i];
+            }
+            zoneMin[b] = lo;
+            zoneMax[b] = hi;
+            zoneSum[b] = s;
+            minVal = min(minVal, lo);
+            maxVal = max(maxVal, hi);
+            sum += s;
+        }
+        total.count = n;
+        total.minVal = minVal;
+        total.maxVal = maxVal;
+        total.sum = sum;
+    }
+
+    const FilteredStats& whole() const { return total; }
+    long long blocks() const { return zoneSum.size(); }
+
+    FilteredStats reduceWhere(InRange pred, QueryCounters* counters = nullptr) const {
+        long long n = data.size();
+        long long nblocks = blocks();
+        long long count = 0, sum = 0, skipped = 0, taken = 0;
+        int minVal = INT_MAX, maxVal = INT_MIN;
+
+        // Straddling blocks cost a full scan while the others cost nothing,
+        // so the blocks are handed out dynamically.
+        #pragma omp parallel for schedule(dynamic, 256) reduction(+:count, sum, skipped, taken) \
+            reduction(min:minVal) reduction(max:maxVal)
+        for (long long b = 0; b < nblocks; ++b) {
+            long long len = min(BLOCK, n - b * BLOCK);
+            if (zoneMax[b] < pred.lo || zoneMin[b] > pred.hi) {
+                ++skipped;
+                continue;
+            }
+            if (pred.lo <= zoneMin[b] && zoneMax[b] <= pred.hi) {
+                ++taken;
+                count += len;
+                sum += zoneSum[b];
+                minVal = min(minVal, zoneMin[b]);
+                maxVal = max(maxVal, zoneMax[b]);
+                continue;
+            }
+
+            const int* block = data.data() + b * BLOCK;
+            long long c = 0, s = 0;
+            int lo = INT_MAX, hi = INT_MIN;
+            #pragma omp simd reduction(+:c, s) reduction(min:lo) reduction(max:hi)
+            for (long long i = 0; i < len; ++i) {
+                bool keep = pred(block[i]);
+                c += keep;
+                s += keep ? block[i] : 0;
+                lo = min(lo, keep ? block[i] : INT_MAX);
+                hi = max(hi, keep ? block[i] : INT_MIN);
+            }
+            count += c;
+            sum += s;
+            minVal = min(minVal, lo);
+            maxVal = max(maxVal, hi);
+        }
+
+        if (counters) {
+            counters->skipped = skipped;
+            counters->taken = taken;
+            counters->scanned = nblocks - skipped - taken;
+        }
+        FilteredStats r;
+        r.count = count;
+        r.minVal = minVal;
+        r.maxVal = maxVal;
+        r.sum = sum;
+        return r;
+    }
+
+private:
+    const vector<int>& data;
+    vector<int> zoneMin;
+    vector<int> zoneMax;
+    vector<long long> zoneSum;
+    FilteredStats total;
+};
+
+bool sameStats(const FilteredStats& a, const FilteredStats& b) {
+    return a.count == b.count && a.sum == b.sum && a.minVal == b.minVal && a.maxVal == b.maxVal;
+}
+
+int main() {
+    const int SIZE = 100000000;
+    const int REPEATS = 10;
+    const uint64_t SEED = 2024;
+    const InRange QUERIES[] = {{9001, INT_MAX}, {2000, 2999}, {4990, 5010}};
+
+    // Shuffled values, as in HPC3.cpp, and values that drift upward with the
+    // index plus noise, like timestamps or sensor readings appended over time.
+    vector<int> shuffled(SIZE), clustered(SIZE);
+    fillUniformInt(shuffled, 0, 9999, SEED);
+    fillUniformInt(clustered, 0, 99, SEED + 1);
+    #pragma omp parallel for simd
+    for (int i = 0; i < SIZE; ++i)
+        clustered[i] += (int)((long long)i * 9900 / SIZE);
+
+    const vector<int>* inputs[] = {&shuffled, &clustered};
+    const char* names[] = {"Shuffled", "Clustered"};
+    for (int d = 0; d < 2; ++d) {
+        const vector<int>& data = *inputs[d];
+
+        auto start = high_resolution_clock::now();
+        ZoneMap zones(data);
+        auto end = high_resolution_clock::now();
+        cout << names[d] << " data, " << zones.blocks() << " zones built in "
+             << duration_cast<milliseconds>(end - start).count() << " ms (Min " << zones.whole().minVal
+             << ", Max " << zones.whole().maxVal << ", Sum " << zones.whole().sum << ")\n";
+
+        for (InRange pred : QUERIES) {
+            FilteredStats expected, answer;
+            QueryCounters counters;
+
+            start = high_resolution_clock::now();
+            for (int k = 0; k < REPEATS; ++k)
+                expected = filteredReduce(data, pred);
+            end = high_resolution_clock::now();
+            double scanTime = duration<double, milli>(end - start).count() / REPEATS;
+
+            start = high_resolution_clock::now();
+            for (int k = 0; k < REPEATS; ++k)
+                answer = zones.reduceWhere(pred, &counters);
+            end = high_resolution_clock::now();
+            double zoneTime = duration<double, milli>(end - start).count() / REPEATS;
+
+            cout << "  [" << pred.lo << ", " << pred.hi << "]: Sum " << answer.sum << ", Count " << answer.count
+                 << " | Full Scan " << scanTime << " ms, Zone Map " << zoneTime << " ms | Skipped "
+                 << counters.skipped << ", Taken " << counters.taken << ", Scanned " << counters.scanned
+                 << " | Correct: " << (sameStats(expected, answer) ? "yes" : "no") << "\n";
+        }
+    }
+
+    return 0;
+}
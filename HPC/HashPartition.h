@@ -0,0 +1,25 @@
+#ifndef HASH_PARTITION_H
+#define HASH_PARTITION_H
+
+// MurmurHash3's 64-bit finalizer: every key bit affects every hash bit, so
+// both the high bits (partition) and the low bits (table slot) are usable.
+inline unsigned long long hashKey(long long key) {
+    unsigned long long h = key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Radix partitioning on the top hash bits: 64 partitions, few enough that each
+// thread's per-partition write cursors stay in cache.
+const int PARTITION_BITS = 6;
+const int PARTITIONS = 1 << PARTITION_BITS;
+
+inline int partitionOf(unsigned long long h) {
+    return h >> (64 - PARTITION_BITS);
+}
+
+#endif
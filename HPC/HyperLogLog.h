@@ -0,0 +1,140 @@
+#ifndef HYPER_LOG_LOG_H
+#define HYPER_LOG_LOG_H
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include "ParallelRandom.h"
+
+// HyperLogLog with 64-bit hashes, as in HLL++, so no large-range correction is
+// needed. Registers are one byte each, which keeps merging a SIMD max.
+class HyperLogLog {
+public:
+    static const int HASH_BLOCK = 256;
+
+    explicit HyperLogLog(int precision = 14) : p(checkedPrecision(precision)), registers(size_t(1) << p, 0) {}
+
+    int precision() const { return p; }
+    size_t bytes() const { return registers.size(); }
+
+    static uint64_t hash(uint64_t x) {
+        return SplitMix64::bits(0, x);
+    }
+
+    void addHash(uint64_t h) { update(registers.data(), p, h); }
+
+    // Hashes a block at a time in a vectorized loop, then applies the
+    // register updates, which are gathers and scatters and stay scalar.
+    template <typename T>
+    void addAll(const T* values, long long n) {
+        uint64_t hashes[HASH_BLOCK];
+        for (long long base = 0; base < n; base += HASH_BLOCK) {
+            int len = std::min<long long>(HASH_BLOCK, n - base);
+            #pragma omp simd
+            for (int i = 0; i < len; ++i)
+                hashes[i] = hash((uint64_t)values[base + i]);
+            for (int i = 0; i < len; ++i)
+                addHash(hashes[i]);
+        }
+    }
+
+    void merge(const HyperLogLog& other) {
+        if (other.p != p)
+            throw std::invalid_argument("cannot merge HyperLogLog sketches of different precision");
+        mergeRegisters(registers.data(), other.registers.data(), registers.size());
+    }
+
+    double estimate() const { return estimate(registers.data(), p); }
+
+    // Layout: 'H' 'L' version precision, then one byte per register.
+    std::vector<uint8_t> serialize() const {
+        std::vector<uint8_t> out = {'H', 'L', 1, (uint8_t)p};
+        out.insert(out.end(), registers.begin(), registers.end());
+        return out;
+    }
+
+    static HyperLogLog deserialize(const std::vector<uint8_t>& in) {
+        if (in.size() < 4 || in[0] != 'H' || in[1] != 'L' || in[2] != 1)
+            throw std::invalid_argument("not a serialized HyperLogLog sketch");
+        HyperLogLog sketch(in[3]);
+        if (in.size() != 4 + sketch.registers.size())
+            throw std::invalid_argument("truncated HyperLogLog sketch");
+        std::copy(in.begin() + 4, in.end(), sketch.registers.begin());
+        return sketch;
+    }
+
+    // The same operations on a bare array of 2^p one-byte registers, for
+    // sketches embedded in fixed-size structs such as MPI messages.
+    static void update(uint8_t* registers, int p, uint64_t h) {
+        uint32_t index = h >> (64 - p);
+        uint64_t rest = (h << p) | (uint64_t(1) << (p - 1));
+        uint8_t rank = __builtin_clzll(rest) + 1;
+        registers[index] = std::max(registers[index], rank);
+    }
+
+    static void mergeRegisters(uint8_t* registers, const uint8_t* other, size_t m) {
+        #pragma omp simd
+        for (size_t i = 0; i < m; ++i)
+            registers[i] = std::max(registers[i], other[i]);
+    }
+
+    // Ertl's improved estimator ("New cardinality estimation algorithms for
+    // HyperLogLog sketches", 2017). It works from the register histogram and
+    // stays unbiased in the small and mid range, where HLL++ needs empirical
+    // bias tables.
+    static double estimate(const uint8_t* registers, int p) {
+        int q = 64 - p;
+        size_t size = size_t(1) << p;
+        double m = size;
+        std::vector<long long> counts(q + 2, 0);
+        for (size_t i = 0; i < size; ++i)
+            ++counts[registers[i]];
+
+        double z = m * tau(1.0 - counts[q + 1] / m);
+        for (int k = q; k >= 1; --k)
+            z = 0.5 * (z + counts[k]);
+        z += m * sigma(counts[0] / m);
+        return m * m / (2.0 * std::log(2.0) * z);
+    }
+
+private:
+    // Runs in the initializer list, so a bad precision, e.g. one read by
+    // deserialize, is rejected before it sizes the registers.
+    static int checkedPrecision(int precision) {
+        if (precision < 4 || precision > 18)
+            throw std::invalid_argument("HyperLogLog precision must be in [4, 18]");
+        return precision;
+    }
+
+    static double sigma(double x) {
+        if (x == 1.0) return INFINITY;
+        double y = 1.0, z = x, prev;
+        do {
+            x *= x;
+            prev = z;
+            z += x * y;
+            y += y;
+        } while (z != prev);
+        return z;
+    }
+
+    static double tau(double x) {
+        if (x == 0.0 || x == 1.0) return 0.0;
+        double y = 1.0, z = 1.0 - x, prev;
+        do {
+            x = std::sqrt(x);
+            prev = z;
+            y *= 0.5;
+            z -= (1.0 - x) * (1.0 - x) * y;
+        } while (z != prev);
+        return z / 3.0;
+    }
+
+    int p;
+    std::vector<uint8_t> registers;
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef PAIRWISE_TREE_H
+#define PAIRWISE_TREE_H
+
+#include <vector>
+#include <omp.h>
+
+// Combines v[0], v[1], ... by a fixed pairwise tree, in place: the shape of
+// the tree depends only on v.size(), so the result does not depend on the
+// thread count. Returns T() for an empty vector.
+template <typename T, typename Op>
+T pairwiseTree(std::vector<T>& v, Op op) {
+    if (v.empty()) return T();
+    for (size_t width = 1; width < v.size(); width *= 2) {
+        #pragma omp parallel for if (v.size() / (2 * width) > 1024)
+        for (long long i = 0; i < (long long)v.size() - (long long)width; i += 2 * width)
+            v[i] = op(v[i], v[i + width]);
+    }
+    return v[0];
+}
+
+#endif
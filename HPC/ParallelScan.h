@@ -0,0 +1,161 @@
+#ifndef PARALLEL_SCAN_H
+#define PARALLEL_SCAN_H
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <type_traits>
+#include <omp.h>
+
+// Scans a block in place, starting from carry. Returns the inclusive total.
+template <typename T, typename Op>
+T scanBlock(T* out, const T* in, size_t n, T carry, Op op, bool inclusive) {
+    if constexpr (std::is_same<Op, std::plus<T>>::value) {
+        T acc = carry;
+        if (inclusive) {
+            #pragma omp simd reduction(inscan, +:acc)
+            for (size_t i = 0; i < n; ++i) {
+                acc += in[i];
+                #pragma omp scan inclusive(acc)
+                out[i] = acc;
+            }
+        } else {
+            #pragma omp simd reduction(inscan, +:acc)
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = acc;
+                #pragma omp scan exclusive(acc)
+                acc += in[i];
+            }
+        }
+        return acc;
+    } else {
+        T acc = carry;
+        for (size_t i = 0; i < n; ++i) {
+            T x = in[i];
+            if (inclusive) {
+                acc = op(acc, x);
+                out[i] = acc;
+            } else {
+                out[i] = acc;
+                acc = op(acc, x);
+            }
+        }
+        return acc;
+    }
+}
+
+template <typename T, typename Op>
+T reduceBlock(const T* in, size_t n, T identity, Op op) {
+    T acc = identity;
+    if constexpr (std::is_same<Op, std::plus<T>>::value) {
+        #pragma omp simd reduction(+:acc)
+        for (size_t i = 0; i < n; ++i)
+            acc += in[i];
+    } else {
+        for (size_t i = 0; i < n; ++i)
+            acc = op(acc, in[i]);
+    }
+    return acc;
+}
+
+// Two-pass blocked scan: reduce each thread's chunk, scan the chunk totals,
+// then rescan each chunk from its offset. out may alias in.
+template <typename T, typename Op>
+void blockedScan(const T* in, T* out, size_t n, T identity, Op op, bool inclusive) {
+    int nthreads = omp_get_max_threads();
+    std::vector<T> partial(nthreads + 1, identity);
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        int t = omp_get_thread_num();
+        int nt = omp_get_num_threads();
+        size_t begin = n * t / nt;
+        size_t end = n * (t + 1) / nt;
+
+        partial[t + 1] = reduceBlock(in + begin, end - begin, identity, op);
+
+        #pragma omp barrier
+        #pragma omp single
+        for (int i = 1; i <= nt; ++i)
+            partial[i] = op(partial[i - 1], partial[i]);
+
+        scanBlock(out + begin, in + begin, end - begin, partial[t], op, inclusive);
+    }
+}
+
+template <typename T, typename Op = std::plus<T>>
+void inclusiveScan(const std::vector<T>& in, std::vector<T>& out, T identity = T(), Op op = Op()) {
+    out.resize(in.size());
+    blockedScan(in.data(), out.data(), in.size(), identity, op, true);
+}
+
+template <typename T, typename Op = std::plus<T>>
+void exclusiveScan(const std::vector<T>& in, std::vector<T>& out, T identity = T(), Op op = Op()) {
+    out.resize(in.size());
+    blockedScan(in.data(), out.data(), in.size(), identity, op, false);
+}
+
+// Single-pass scan with decoupled look-back. Tiles are claimed in order from a
+// ticket counter, so every predecessor a tile waits on is already being worked on.
+template <typename T>
+struct TileStatus {
+    enum : int { INVALID = 0, AGGREGATE = 1, PREFIX = 2 };
+    std::atomic<int> flag;
+    T aggregate;
+    T prefix;
+};
+
+template <typename T, typename Op = std::plus<T>>
+void lookbackScan(const std::vector<T>& in, std::vector<T>& out, T identity = T(), Op op = Op(),
+                  bool inclusive = true, size_t tileSize = 1 << 14) {
+    size_t n = in.size();
+    out.resize(n);
+    size_t tiles = (n + tileSize - 1) / tileSize;
+    std::vector<TileStatus<T>> status(tiles);
+    for (auto& s : status)
+        s.flag.store(TileStatus<T>::INVALID, std::memory_order_relaxed);
+    std::atomic<size_t> ticket(0);
+
+    #pragma omp parallel
+    {
+        for (;;) {
+            size_t tile = ticket.fetch_add(1, std::memory_order_relaxed);
+            if (tile >= tiles) break;
+
+            size_t begin = tile * tileSize;
+            size_t len = std::min(tileSize, n - begin);
+            T aggregate = reduceBlock(in.data() + begin, len, identity, op);
+
+            T exclusive = identity;
+            if (tile == 0) {
+                status[0].prefix = aggregate;
+                status[0].flag.store(TileStatus<T>::PREFIX, std::memory_order_release);
+            } else {
+                status[tile].aggregate = aggregate;
+                status[tile].flag.store(TileStatus<T>::AGGREGATE, std::memory_order_release);
+
+                size_t pred = tile - 1;
+                for (;;) {
+                    int flag;
+                    while ((flag = status[pred].flag.load(std::memory_order_acquire)) == TileStatus<T>::INVALID)
+                        std::this_thread::yield();
+                    if (flag == TileStatus<T>::PREFIX) {
+                        exclusive = op(status[pred].prefix, exclusive);
+                        break;
+                    }
+                    exclusive = op(status[pred].aggregate, exclusive);
+                    --pred;
+                }
+
+                status[tile].prefix = op(exclusive, aggregate);
+                status[tile].flag.store(TileStatus<T>::PREFIX, std::memory_order_release);
+            }
+
+            scanBlock(out.data() + begin, in.data() + begin, len, exclusive, op, inclusive);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Per-thread hardware counters around a kernel call, read with Linux
+// perf_event_open. Every thread of the process alive at the start gets its own
+// set of counters, so start worker pools before measuring; threads spawned
+// during the kernel are folded into their parent's counts when they exit.
+// A thread is listed if any of its counts is nonzero, and a spinning idle
+// worker counts like a busy one, so park the pool (ThreadPool::park) before
+// each kernel: then the listed threads are the caller plus the workers that
+// woke for its tasks, including the spin they do after their last task while
+// the kernel is still running. Only
+// user-space events are requested, which perf_event_paranoid up to 2 allows.
+// An event that cannot be opened (no PMU in a VM, a stricter paranoid level,
+// seccomp) is reported as unavailable rather than failing the run; task-clock
+// is a software event and usually still works.
+
+enum CounterEvent {
+    TASK_CLOCK,
+    CYCLES,
+    INSTRUCTIONS,
+    LLC_MISSES,
+    BRANCH_MISSES,
+    DTLB_MISSES,
+    COUNTER_EVENTS
+};
+
+struct CounterSpec {
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+};
+
+inline const CounterSpec& counterSpec(int event) {
+    static const CounterSpec specs[COUNTER_EVENTS] = {
+        {"task-clock", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"LLC misses", PERF_TYPE_HW_CACHE,
+         PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {"branch misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {"dTLB misses", PERF_TYPE_HW_CACHE,
+         PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    };
+    return specs[event];
+}
+
+struct ThreadCounters {
+    int tid;
+    double value[COUNTER_EVENTS];   // task-clock in ns, the rest in events
+};
+
+struct KernelCounters {
+    std::string name;
+    long long elements = 0;
+    double seconds = 0.0;
+    bool available[COUNTER_EVENTS] = {};
+    std::string error;                  // why the first unavailable event failed
+    std::vector<ThreadCounters> threads; // threads with a nonzero count
+
+    double total(int event) const {
+        double sum = 0.0;
+        for (const ThreadCounters& t : threads)
+            sum += t.value[event];
+        return sum;
+    }
+};
+
+class PerfCounters {
+public:
+    PerfCounters() {
+        for (int e = 0; e < COUNTER_EVENTS; ++e)
+            available[e] = true;
+        DIR* dir = opendir("/proc/self/task");
+        if (!dir) return;
+        while (dirent* entry = readdir(dir)) {
+            int tid = std::atoi(entry->d_name);
+            if (tid <= 0) continue;
+            Thread t;
+            t.tid = tid;
+            for (int e = 0; e < COUNTER_EVENTS; ++e)
+                t.fd[e] = available[e] ? open(e, tid) : -1;
+            threads.push_back(t);
+        }
+        closedir(dir);
+    }
+
+    ~PerfCounters() {
+        for (Thread& t : threads)
+            for (int fd : t.fd)
+                if (fd >= 0) close(fd);
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    void start() {
+        control(PERF_EVENT_IOC_RESET);
+        control(PERF_EVENT_IOC_ENABLE);
+    }
+
+    void stop() { control(PERF_EVENT_IOC_DISABLE); }
+
+    // Counts are scaled by enabled/running time in case the kernel multiplexed
+    // the events onto fewer hardware counters.
+    void collect(KernelCounters& out) const {
+        for (int e = 0; e < COUNTER_EVENTS; ++e)
+            out.available[e] = available[e];
+        out.error = error;
+        for (const Thread& t : threads) {
+            ThreadCounters c;
+            c.tid = t.tid;
+            bool ran = false;
+            for (int e = 0; e < COUNTER_EVENTS; ++e) {
+                c.value[e] = 0.0;
+                uint64_t v[3];
+                if (t.fd[e] < 0 || ::read(t.fd[e], v, sizeof(v)) != sizeof(v) || v[2] == 0) continue;
+                c.value[e] = (double)v[0] * v[1] / v[2];
+                ran = ran || c.value[e] > 0;
+            }
+            if (ran) out.threads.push_back(c);
+        }
+    }
+
+private:
+    struct Thread {
+        int tid;
+        int fd[COUNTER_EVENTS];
+    };
+
+    int open(int event, int tid) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = counterSpec(event).type;
+        attr.config = counterSpec(event).config;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        int fd = syscall(SYS_perf_event_open, &attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC);
+        // A thread that exited since the directory was read is not an error.
+        if (fd < 0 && errno != ESRCH) {
+            available[event] = false;
+            if (error.empty()) error = std::string("perf_event_open: ") + std::strerror(errno);
+        }
+        return fd;
+    }
+
+    void control(unsigned long request) {
+        for (Thread& t : threads)
+            for (int fd : t.fd)
+                if (fd >= 0) ioctl(fd, request, 0);
+    }
+
+    std::vector<Thread> threads;
+    bool available[COUNTER_EVENTS];
+    std::string error;
+};
+
+// Runs kernel() once with counters on every thread and returns the counts.
+template <typename F>
+KernelCounters countKernel(const std::string& name, long long elements, F kernel) {
+    KernelCounters result;
+    result.name = name;
+    result.elements = elements;
+    PerfCounters counters;
+    auto start = std::chrono::steady_clock::now();
+    counters.start();
+    kernel();
+    counters.stop();
+    auto end = std::chrono::steady_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    counters.collect(result);
+    return result;
+}
+
+// One line per listed thread, then the totals: IPC, and misses per element,
+// which tell a compute-bound kernel from a cache-, branch- or TLB-bound one.
+inline void printCounters(const KernelCounters& k, std::ostream& out = std::cout) {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    const char* sep = " ";
+    auto field = [&](const std::string& label) -> std::ostream& {
+        out << sep << label << " ";
+        sep = ", ";
+        return out;
+    };
+    bool ipc = k.available[CYCLES] && k.available[INSTRUCTIONS];
+
+    out << std::fixed << std::setprecision(2);
+    out << "Counters for " << k.name << ": " << k.elements << " elements, " << k.seconds * 1e3 << " ms, "
+        << k.threads.size() << " threads with nonzero counts\n";
+
+    for (const ThreadCounters& t : k.threads) {
+        out << "  thread " << t.tid << ":";
+        sep = " ";
+        if (k.available[TASK_CLOCK]) field("task-clock") << t.value[TASK_CLOCK] / 1e6 << " ms";
+        if (k.available[CYCLES]) field("cycles") << (long long)t.value[CYCLES];
+        if (k.available[INSTRUCTIONS]) field("instructions") << (long long)t.value[INSTRUCTIONS];
+        if (ipc && t.value[CYCLES] > 0) field("IPC") << t.value[INSTRUCTIONS] / t.value[CYCLES];
+        out << "\n";
+    }
+
+    double elements = k.elements > 0 ? (double)k.elements : 1.0;
+    out << "  total:";
+    sep = " ";
+    if (k.available[TASK_CLOCK]) field("task-clock") << k.total(TASK_CLOCK) / 1e6 << " ms";
+    if (ipc && k.total(CYCLES) > 0) {
+        field("IPC") << k.total(INSTRUCTIONS) / k.total(CYCLES);
+        field("cycles/element") << k.total(CYCLES) / elements;
+    }
+    out << std::setprecision(4);
+    for (int e : {LLC_MISSES, BRANCH_MISSES, DTLB_MISSES})
+        if (k.available[e]) field(std::string(counterSpec(e).name) + "/element") << k.total(e) / elements;
+    out << "\n";
+
+    std::string missing;
+    for (int e = 0; e < COUNTER_EVENTS; ++e)
+        if (!k.available[e]) missing += (missing.empty() ? "" : ", ") + std::string(counterSpec(e).name);
+    if (!missing.empty()) out << "  unavailable: " << missing << " (" << k.error << ")\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef RANGE_PREDICATE_H
+#define RANGE_PREDICATE_H
+
+#include <vector>
+#include <climits>
+#include <algorithm>
+#include <omp.h>
+
+// Selects lo <= x <= hi. Covers "x > t" as {t + 1, INT_MAX} and "x < t" as
+// {INT_MIN, t - 1}, and is simple enough to evaluate on whole SIMD registers or
+// against a block's min/max.
+struct InRange {
+    int lo;
+    int hi;
+    bool operator()(int x) const { return lo <= x && x <= hi; }
+};
+
+struct FilteredStats {
+    long long count = 0;
+    int minVal = INT_MAX;
+    int maxVal = INT_MIN;
+    long long sum = 0;
+};
+
+// The HPC3 reduction restricted to selected elements, with no intermediate array.
+template <typename Pred>
+FilteredStats filteredReduce(const std::vector<int>& data, Pred pred) {
+    long long n = data.size();
+    long long count = 0, sum = 0;
+    int minVal = INT_MAX, maxVal = INT_MIN;
+
+    #pragma omp parallel for simd reduction(+:count, sum) reduction(min:minVal) reduction(max:maxVal)
+    for (long long i = 0; i < n; ++i) {
+        bool keep = pred(data[i]);
+        count += keep;
+        sum += keep ? data[i] : 0;
+        minVal = std::min(minVal, keep ? data[i] : INT_MAX);
+        maxVal = std::max(maxVal, keep ? data[i] : INT_MIN);
+    }
+
+    FilteredStats stats;
+    stats.count = count;
+    stats.sum = sum;
+    stats.minVal = minVal;
+    stats.maxVal = maxVal;
+    return stats;
+}
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// A persistent pool of worker threads with one work-stealing deque each. The
+// threads are started once and live for the whole program, so a parallel loop
+// costs a few task pushes instead of waking a fresh team. Workers take their
+// own newest task first (cache-warm, depth-first) and steal the oldest task of
+// another worker (the largest remaining piece of work). A thread waiting for a
+// TaskGroup runs queued tasks meanwhile, so nested parallel calls reuse the
+// same threads and never oversubscribe the machine. Tasks must not throw.
+
+class SpinLock {
+public:
+    void lock() {
+        while (flag.test_and_set(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+    void unlock() { flag.clear(std::memory_order_release); }
+
+private:
+    std::atomic_flag flag = ATOMIC_FLAG_INIT;
+};
+
+class TaskGroup;
+
+struct PoolTask {
+    std::function<void()> fn;
+    TaskGroup* group;
+};
+
+struct alignas(64) WorkQueue {
+    SpinLock lock;
+    std::deque<PoolTask*> tasks;
+};
+
+class ThreadPool {
+public:
+    // Sized by OMP_NUM_THREADS when set, like the OpenMP code it replaces.
+    static ThreadPool& global() {
+        static ThreadPool pool(defaultThreads());
+        return pool;
+    }
+
+    explicit ThreadPool(int threads) : queues(threads < 1 ? 1 : threads) {
+        for (int w = 1; w < (int)queues.size(); ++w)
+            workers.emplace_back([this, w] { workerLoop(w); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (std::thread& t : workers)
+            t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return queues.size(); }
+
+    // Pushes onto the calling worker's deque. Threads outside the pool share
+    // deque 0, which the workers steal from like any other.
+    void submit(PoolTask* task) {
+        WorkQueue& q = queues[ownIndex(this)];
+        q.lock.lock();
+        q.tasks.push_back(task);
+        q.lock.unlock();
+        queued.fetch_add(1);
+        if (sleepers.load() > 0) {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            wakeup.notify_one();
+        }
+    }
+
+    // Sends idle workers to sleep without finishing their spin and returns once
+    // all of them are asleep, so threads given no work cost no CPU time until
+    // the next submit. Call it with no tasks pending, e.g. before measuring a
+    // kernel.
+    void park() {
+        parking.store(true);
+        while (sleepers.load() < (int)workers.size())
+            std::this_thread::yield();
+        parking.store(false);
+    }
+
+    // Runs one queued task, own deque first, and reports whether there was one.
+    bool runOne() {
+        if (queued.load(std::memory_order_relaxed) == 0) return false;
+        int self = ownIndex(this);
+        PoolTask* task = popBack(queues[self]);
+        for (int k = 1; !task && k < (int)queues.size(); ++k)
+            task = stealFront(queues[(self + k) % queues.size()]);
+        if (!task) return false;
+        queued.fetch_sub(1);
+        execute(task);
+        return true;
+    }
+
+private:
+    static int defaultThreads() {
+        const char* env = std::getenv("OMP_NUM_THREADS");
+        int n = env ? std::atoi(env) : 0;
+        if (n < 1) n = std::thread::hardware_concurrency();
+        return n < 1 ? 1 : n;
+    }
+
+    // Index of the calling thread in this pool, or 0 if it is not a worker.
+    static int& workerIndex() {
+        static thread_local int index = 0;
+        return index;
+    }
+
+    static const ThreadPool*& workerPool() {
+        static thread_local const ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    static int ownIndex(const ThreadPool* pool) {
+        return workerPool() == pool ? workerIndex() : 0;
+    }
+
+    static PoolTask* popBack(WorkQueue& q) {
+        q.lock.lock();
+        PoolTask* task = nullptr;
+        if (!q.tasks.empty()) {
+            task = q.tasks.back();
+            q.tasks.pop_back();
+        }
+        q.lock.unlock();
+        return task;
+    }
+
+    static PoolTask* stealFront(WorkQueue& q) {
+        q.lock.lock();
+        PoolTask* task = nullptr;
+        if (!q.tasks.empty()) {
+            task = q.tasks.front();
+            q.tasks.pop_front();
+        }
+        q.lock.unlock();
+        return task;
+    }
+
+    static void execute(PoolTask* task);
+
+    // Idle workers keep yielding for a while, so back-to-back parallel loops
+    // find them awake, and only then sleep until new work is submitted.
+    void workerLoop(int index) {
+        const int SPINS = 4096;
+        workerIndex() = index;
+        workerPool() = this;
+        int idle = 0;
+        while (true) {
+            if (runOne()) {
+                idle = 0;
+                continue;
+            }
+            if (++idle < SPINS && !parking.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(sleepLock);
+            sleepers.fetch_add(1);
+            wakeup.wait(guard, [this] { return stopping || queued.load() > 0; });
+            sleepers.fetch_sub(1);
+            if (stopping) return;
+            idle = 0;
+        }
+    }
+
+    std::vector<WorkQueue> queues;
+    std::vector<std::thread> workers;
+    std::atomic<long> queued{0};
+    std::atomic<int> sleepers{0};
+    std::atomic<bool> parking{false};
+    std::mutex sleepLock;
+    std::condition_variable wakeup;
+    bool stopping = false;
+};
+
+// Tasks spawned together; wait() returns once all of them have finished and
+// helps run queued tasks while it waits.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::global()) : pool(pool) {}
+    ~TaskGroup() { wait(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template <typename F>
+    void run(F&& f) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool.submit(new PoolTask{std::function<void()>(std::forward<F>(f)), this});
+    }
+
+    void wait() {
+        while (pending.load(std::memory_order_acquire) > 0)
+            if (!pool.runOne()) std::this_thread::yield();
+    }
+
+private:
+    friend class ThreadPool;
+
+    ThreadPool& pool;
+    std::atomic<long> pending{0};
+};
+
+inline void ThreadPool::execute(PoolTask* task) {
+    task->fn();
+    task->group->pending.fetch_sub(1, std::memory_order_release);
+    delete task;
+}
+
+// Lazy binary splitting: the range is halved, the upper half handed to the
+// pool, until pieces are at most `grain` long. Idle threads steal the largest
+// pending halves, so load balances without a fixed schedule.
+template <typename F>
+void splitRange(TaskGroup& group, long long begin, long long end, long long grain, const F& body) {
+    while (end - begin > grain) {
+        long long mid = begin + (end - begin) / 2;
+        group.run([&group, mid, end, grain, &body] { splitRange(group, mid, end, grain, body); });
+        end = mid;
+    }
+    body(begin, end);
+}
+
+// Calls body(lo, hi) on disjoint pieces covering [begin, end). A pool of one
+// thread runs the whole range inline.
+template <typename F>
+void parallelFor(long long begin, long long end, long long grain, const F& body) {
+    if (end <= begin) return;
+    if (grain < 1) grain = 1;
+    if (end - begin <= grain || ThreadPool::global().size() == 1) {
+        body(begin, end);
+        return;
+    }
+    TaskGroup group;
+    splitRange(group, begin, end, grain, body);
+    group.wait();
+}
+
+// Splits into about eight pieces per thread.
+template <typename F>
+void parallelFor(long long begin, long long end, const F& body) {
+    long long pieces = 8LL * ThreadPool::global().size();
+    parallelFor(begin, end, (end - begin + pieces - 1) / pieces, body);
+}
+
+// Reduces body(lo, hi) over pieces of at most `grain` elements with combine.
+// The combining tree depends only on the range and grain, never on which
+// thread ran what, so the result is the same at any pool size.
+template <typename T, typename Body, typename Combine>
+T parallelReduce(long long begin, long long end, long long grain, T identity, const Body& body, const Combine& combine) {
+    if (end <= begin) return identity;
+    if (grain < 1) grain = 1;
+    if (end - begin <= grain) return body(begin, end);
+    long long mid = begin + (end - begin) / 2;
+    T right = identity;
+    TaskGroup group;
+    group.run([&] { right = parallelReduce(mid, end, grain, identity, body, combine); });
+    T left = parallelReduce(begin, mid, grain, identity, body, combine);
+    group.wait();
+    return combine(left, right);
+}
+
+template <typename F, typename G>
+void parallelInvoke(const F& f, const G& g) {
+    if (ThreadPool::global().size() == 1) {
+        f();
+        g();
+        return;
+    }
+    TaskGroup group;
+    group.run(g);
+    f();
+    group.wait();
+}
+
+#endif